@@ -0,0 +1,197 @@
+/**
+ * @file af.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Alternative frequency (AF) codes of 0A groups and assembly of AF lists (method A and B).
+ *
+ * Frequencies are kept as integer channels and only formatted at output:
+ *   bits 0-7   AF code (FM: 87.5 MHz + code * 100 kHz, LF/MF: code of the 9 kHz raster)
+ *   bit 8      AF_CHANNEL_LFMF, the code is an LF/MF one
+ *   bit 9      AF_CHANNEL_REGIONAL, method B: the frequency carries a regional variant
+ */
+#ifndef AF_HPP
+#define AF_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#define AF_CODE_FM_FIRST (1)      // 87.6 MHz
+#define AF_CODE_FM_LAST (204)     // 107.9 MHz
+#define AF_CODE_FILLER (205)
+#define AF_CODE_COUNT_BASE (224)  // 225 - 249: number of frequencies in the list
+#define AF_CODE_COUNT_LAST (249)
+#define AF_CODE_LFMF (250)        // An LF/MF frequency follows
+#define AF_CODE_LF_LAST (15)      // LF 153 - 279 kHz, MF 531 - 1602 kHz up to code 135
+#define AF_CODE_MF_LAST (135)
+#define AF_FM_BASE (875)          // 87.5 MHz in 100 kHz
+#define AF_LIST_MAX (AF_CODE_COUNT_LAST - AF_CODE_COUNT_BASE)
+#define AF_METHOD_B_LISTS (4)     // Method B lists kept per station, one per transmitter
+#define AF_CHANNEL_CODE (0xFF)
+#define AF_CHANNEL_LFMF (0x100)
+#define AF_CHANNEL_REGIONAL (0x200)
+
+bool af_is_fm(const uint8_t code) {
+    return code >= AF_CODE_FM_FIRST && code <= AF_CODE_FM_LAST;
+}
+
+/**
+ * @brief AF code of an FM frequency in MHz with at most one decimal ("104.5", "98").
+ *
+ * @throws std::invalid_argument if the text is not a frequency of the 87.6 - 107.9 MHz band
+ */
+uint8_t af_parse_fm(const std::string &text) {
+    uint32_t tenths = 0;
+    std::size_t i = 0;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9' && tenths < 10000; ++i) {
+        tenths = tenths * 10 + static_cast<uint32_t>(text[i] - '0');
+    }
+    const bool has_integer = i > 0;
+    tenths *= 10;
+    if (i < text.size() && text[i] == '.') {
+        ++i;
+        if (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+            tenths += static_cast<uint32_t>(text[i++] - '0');
+        }
+        // Only zeros may follow the 100 kHz digit
+        while (i < text.size() && text[i] == '0') {
+            ++i;
+        }
+    }
+    if (!has_integer || i != text.size() || tenths < AF_FM_BASE + AF_CODE_FM_FIRST || tenths > AF_FM_BASE + AF_CODE_FM_LAST) {
+        throw std::invalid_argument("Invalid frequency value: " + text + ". Expected 87.6 - 107.9 MHz in 100 kHz steps");
+    }
+    return static_cast<uint8_t>(tenths - AF_FM_BASE);
+}
+
+/**
+ * @brief Prints a channel: FM in MHz with one decimal, LF/MF in kHz.
+ */
+void af_print(std::ostream &out, const uint16_t channel) {
+    const uint32_t code = channel & AF_CHANNEL_CODE;
+    if (channel & AF_CHANNEL_LFMF) {
+        out << (code <= AF_CODE_LF_LAST ? 153 + (code - 1) * 9 : 531 + (code - AF_CODE_LF_LAST - 1) * 9) << " kHz";
+    } else {
+        out << (AF_FM_BASE + code) / 10 << "." << (AF_FM_BASE + code) % 10;
+    }
+}
+
+/**
+ * @brief One AF list: method A (all frequencies of the network) or method B (frequencies of one transmitter).
+ */
+struct AfList {
+    bool method_b = false;
+    uint16_t tuned = 0;        // Method B: the transmitter the list belongs to
+    uint8_t expected = 0;      // Frequencies announced by the count code
+    uint8_t received = 0;      // Frequencies received, method B counts the tuned frequency of every pair
+    uint8_t count = 0;         // Channels stored
+    uint16_t channels[AF_LIST_MAX];
+
+    bool operator==(const AfList &other) const {
+        return method_b == other.method_b && tuned == other.tuned && count == other.count
+               && std::memcmp(channels, other.channels, count * sizeof(channels[0])) == 0;
+    }
+
+    void add(const uint16_t channel) {
+        if (count < AF_LIST_MAX) {
+            channels[count++] = channel;
+        }
+    }
+};
+
+/**
+ * @brief Assembles the AF lists of one station from the code pairs of successive 0A groups.
+ */
+class AfAssembler {
+private:
+    AfList building;
+    bool active = false;
+
+    /**
+     * @return true if the completed list differs from the stored one
+     */
+    bool _complete() {
+        active = false;
+        if (!building.method_b) {
+            const bool changed = !(method_a == building);
+            method_a = building;
+            has_method_a = true;
+            return changed;
+        }
+
+        // Method B: one list per transmitter, the tuned frequency opens it and is not an AF itself
+        building.count = building.count > 0 ? building.count - 1 : 0;
+        std::memmove(building.channels, building.channels + 1, building.count * sizeof(building.channels[0]));
+        int slot = 0;
+        while (slot < method_b_count && method_b[slot].tuned != building.tuned) {
+            slot++;
+        }
+        if (slot == AF_METHOD_B_LISTS) {
+            slot = method_b_next;
+            method_b_next = (method_b_next + 1) % AF_METHOD_B_LISTS;
+        } else if (slot == method_b_count) {
+            method_b_count++;
+        }
+        const bool changed = !(method_b[slot] == building);
+        method_b[slot] = building;
+        return changed;
+    }
+
+public:
+    AfList method_a;
+    bool has_method_a = false;
+    AfList method_b[AF_METHOD_B_LISTS];
+    int method_b_count = 0;
+    int method_b_next = 0; // Replaced once all method B slots are taken
+
+    bool has_lists() const {
+        return has_method_a || method_b_count > 0;
+    }
+
+    /**
+     * @brief Takes the two AF codes of block C.
+     *
+     * @return true if a list was completed and differs from the one received before
+     */
+    bool push(const uint8_t first, const uint8_t second) {
+        if (first > AF_CODE_COUNT_BASE && first <= AF_CODE_COUNT_LAST) {
+            // Count code: a new list, the second code is its first frequency (method B: the tuned one)
+            building = AfList();
+            building.expected = static_cast<uint8_t>(first - AF_CODE_COUNT_BASE);
+            active = true;
+            if (af_is_fm(second)) {
+                building.tuned = second;
+                building.add(second);
+                building.received = 1;
+            }
+        } else if (!active) {
+            return false;
+        } else if (first == AF_CODE_LFMF) {
+            if (second >= 1 && second <= AF_CODE_MF_LAST) {
+                building.add(static_cast<uint16_t>(AF_CHANNEL_LFMF | second));
+            }
+            building.received++;
+        } else if (building.tuned != 0 && af_is_fm(first) && af_is_fm(second) && (first == building.tuned || second == building.tuned)) {
+            // Method B: every pair holds the tuned frequency, the descending order marks a regional variant
+            building.method_b = true;
+            const uint8_t other = first == building.tuned ? second : first;
+            building.add(static_cast<uint16_t>(other | (first > second ? AF_CHANNEL_REGIONAL : 0)));
+            building.received = static_cast<uint8_t>(building.received + 2);
+        } else {
+            for (const uint8_t code: {first, second}) {
+                if (af_is_fm(code)) {
+                    building.add(code);
+                    building.received++;
+                }
+            }
+        }
+        return active && building.received >= building.expected ? _complete() : false;
+    }
+};
+
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file biphase.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Differential encoding and biphase symbol coding of the RDS bitstream.
+ *
+ * On air every data bit d is first differentially encoded (e = d xor previous e)
+ * and then sent as two biphase half-symbols: e = 1 -> "10", e = 0 -> "01".
+ * Both directions work a byte at a time through tables built once at startup.
+ */
+#ifndef BIPHASE_HPP
+#define BIPHASE_HPP
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define BIPHASE_PHASE_PROBE (1024) // Symbols checked to find the half-symbol phase
+
+class BiphaseTables {
+public:
+    uint16_t encode[2][256];              // [previous e][data byte] -> 16 half-symbols, first bit is the MSB
+    uint8_t symbol_bits[256];             // 4 half-symbol pairs -> 4 differential bits (first pair is the MSB)
+    uint8_t symbol_invalid[256];          // 4 half-symbol pairs -> pairs that are "00" or "11"
+    uint8_t differential_decode[2][256];  // [previous e][differential byte] -> data byte
+
+    BiphaseTables() {
+        for (int byte = 0; byte < 256; ++byte) {
+            for (int state = 0; state < 2; ++state) {
+                int previous = state;
+                uint16_t symbols = 0;
+                int decoded = 0;
+                int previous_decode = state;
+                for (int bit = 7; bit >= 0; --bit) {
+                    const int value = (byte >> bit) & 0x1;
+                    previous ^= value;
+                    symbols = static_cast<uint16_t>((symbols << 2) | (previous ? 0x2 : 0x1));
+                    decoded = (decoded << 1) | (value ^ previous_decode);
+                    previous_decode = value;
+                }
+                encode[state][byte] = symbols;
+                differential_decode[state][byte] = static_cast<uint8_t>(decoded);
+            }
+
+            int bits = 0;
+            int invalid = 0;
+            for (int pair = 3; pair >= 0; --pair) {
+                const int symbols = (byte >> (pair * 2)) & 0x3;
+                // NOTE: An invalid pair is decided by its first half-symbol
+                bits = (bits << 1) | (symbols >> 1);
+                invalid += symbols == 0x0 || symbols == 0x3;
+            }
+            symbol_bits[byte] = static_cast<uint8_t>(bits);
+            symbol_invalid[byte] = static_cast<uint8_t>(invalid);
+        }
+    }
+};
+
+const BiphaseTables biphase_tables;
+
+/**
+ * @brief Differentially encodes and biphase codes packed bits (MSB first).
+ *
+ * @param bits Packed data bits
+ * @param count Number of data bytes
+ * @param symbols Output, 2 * count bytes of packed half-symbols
+ * @param state Last differential bit, carried between calls (0 at the start of a stream)
+ */
+void biphase_encode(const uint8_t *bits, const std::size_t count, uint8_t *symbols, uint8_t &state) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint16_t word = biphase_tables.encode[state][bits[i]];
+        symbols[2 * i] = static_cast<uint8_t>(word >> 8);
+        symbols[2 * i + 1] = static_cast<uint8_t>(word);
+        state = static_cast<uint8_t>((word & 0x3) == 0x2); // Last pair "10" -> e = 1
+    }
+}
+
+/**
+ * @brief Undoes biphase coding and differential encoding of packed half-symbols (MSB first).
+ *
+ * @param symbols Packed half-symbols, aligned to a symbol pair
+ * @param count Number of data bytes to produce (2 * count symbol bytes are read)
+ * @param bits Output, count bytes of packed data bits
+ * @param state Last differential bit, carried between calls (0 at the start of a stream)
+ * @return Number of invalid half-symbol pairs ("00" or "11")
+ */
+uint64_t biphase_decode(const uint8_t *symbols, const std::size_t count, uint8_t *bits, uint8_t &state) {
+    uint64_t invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint8_t high = symbols[2 * i];
+        const uint8_t low = symbols[2 * i + 1];
+        invalid += biphase_tables.symbol_invalid[high] + biphase_tables.symbol_invalid[low];
+        const auto differential = static_cast<uint8_t>((biphase_tables.symbol_bits[high] << 4) | biphase_tables.symbol_bits[low]);
+        bits[i] = biphase_tables.differential_decode[state][differential];
+        state = differential & 0x1;
+    }
+    return invalid;
+}
+
+/**
+ * @brief Biphase codes a '0'/'1' bitstream, returns '0'/'1' half-symbols (two per bit).
+ *
+ * @throws std::invalid_argument if the bitstream contains other characters
+ */
+std::string biphase_encode_ascii(const std::string &bits) {
+    std::string symbols;
+    symbols.reserve(bits.size() * 2);
+    uint8_t state = 0;
+    std::size_t position = 0;
+    uint8_t byte;
+    uint8_t encoded[2];
+    for (; position + 8 <= bits.size(); position += 8) {
+        if (!ascii_to_byte(bits.c_str() + position, byte)) {
+            throw std::invalid_argument("Invalid bitstream, expected only '0' and '1'.");
+        }
+        biphase_encode(&byte, 1, encoded, state);
+        for (int bit = 15; bit >= 0; --bit) {
+            symbols.push_back(static_cast<char>('0' + (((encoded[0] << 8 | encoded[1]) >> bit) & 0x1)));
+        }
+    }
+
+    // Bits after the last whole byte
+    for (; position < bits.size(); ++position) {
+        if (bits[position] != '0' && bits[position] != '1') {
+            throw std::invalid_argument("Invalid bitstream, expected only '0' and '1'.");
+        }
+        state = static_cast<uint8_t>(state ^ (bits[position] - '0'));
+        symbols.append(state ? "10" : "01");
+    }
+    return symbols;
+}
+
+/**
+ * @brief Undoes biphase coding of '0'/'1' half-symbol decisions, whitespace is skipped.
+ * The stream may start in the middle of a symbol, the half-symbol phase with fewer invalid pairs
+ * among the first BIPHASE_PHASE_PROBE symbols is used.
+ *
+ * @param invalid Number of invalid half-symbol pairs
+ * @return '0'/'1' bitstream
+ * @throws std::invalid_argument if the input contains other characters
+ */
+std::string biphase_decode_ascii(const char *text, const std::size_t size, uint64_t &invalid) {
+    std::vector<char> symbols;
+    symbols.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (text[i] == '0' || text[i] == '1') {
+            symbols.push_back(text[i]);
+        } else if (!std::isspace(static_cast<unsigned char>(text[i]))) {
+            throw std::invalid_argument("Invalid symbol stream, expected only '0' and '1'.");
+        }
+    }
+
+    int invalid_by_phase[2] = {0, 0};
+    for (std::size_t i = 0; i + 1 < symbols.size() && i < BIPHASE_PHASE_PROBE; ++i) {
+        invalid_by_phase[i % 2] += symbols[i] == symbols[i + 1];
+    }
+    std::size_t position = invalid_by_phase[1] < invalid_by_phase[0] ? 1 : 0;
+
+    std::string bits;
+    bits.reserve(symbols.size() / 2);
+    uint8_t state = 0;
+    uint8_t packed[2];
+    uint8_t byte;
+    invalid = 0;
+    for (; position + 16 <= symbols.size(); position += 16) {
+        ascii_to_byte(symbols.data() + position, packed[0]);
+        ascii_to_byte(symbols.data() + position + 8, packed[1]);
+        invalid += biphase_decode(packed, 1, &byte, state);
+        for (int bit = 7; bit >= 0; --bit) {
+            bits.push_back(static_cast<char>('0' + ((byte >> bit) & 0x1)));
+        }
+    }
+
+    // Pairs after the last whole byte, a lone trailing half-symbol is dropped
+    for (; position + 2 <= symbols.size(); position += 2) {
+        const int differential = symbols[position] - '0';
+        invalid += symbols[position] == symbols[position + 1];
+        bits.push_back(static_cast<char>('0' + (differential ^ state)));
+        state = static_cast<uint8_t>(differential);
+    }
+    return bits;
+}
+
+
+#endif
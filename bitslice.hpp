@@ -0,0 +1,424 @@
+/**
+ * @file bitslice.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Bit-sliced group synchronization of many independent bitstreams (one station per lane).
+ * Bit k of a lane word belongs to stream k, so one XOR of two lane words does the work of
+ * 64 (uint64_t) or 256 (bitslice_u256) scalar XORs. The syndrome of the newest 26 bits is the
+ * window polynomial mod g(x), so it is updated every bit with XORs only:
+ *
+ *   S' = x S mod g + in + out x^26 mod g
+ *
+ * and compared with the offset words as lane masks. Only the lanes that complete a block
+ * leave the sliced form.
+ */
+#ifndef BITSLICE_HPP
+#define BITSLICE_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#define BITSLICE_HISTORY (2 * BLOCK_ROW_SIZE) // Bits kept per lane: the previous and the newest block
+
+/**
+ * @brief 256 lanes. Plain 64-bit parts (no over-aligned vector type, so it can live in heap objects
+ * under C++14), the element-wise operators compile to 256-bit instructions where AVX2 is enabled.
+ */
+struct bitslice_u256 {
+    uint64_t parts[4];
+
+    bitslice_u256 &operator&=(const bitslice_u256 &other) {
+        for (int k = 0; k < 4; ++k) {
+            parts[k] &= other.parts[k];
+        }
+        return *this;
+    }
+
+    bitslice_u256 &operator|=(const bitslice_u256 &other) {
+        for (int k = 0; k < 4; ++k) {
+            parts[k] |= other.parts[k];
+        }
+        return *this;
+    }
+
+    bitslice_u256 &operator^=(const bitslice_u256 &other) {
+        for (int k = 0; k < 4; ++k) {
+            parts[k] ^= other.parts[k];
+        }
+        return *this;
+    }
+
+    bitslice_u256 operator~() const {
+        bitslice_u256 result;
+        for (int k = 0; k < 4; ++k) {
+            result.parts[k] = ~parts[k];
+        }
+        return result;
+    }
+
+    bitslice_u256 operator&(const bitslice_u256 &other) const {
+        bitslice_u256 result = *this;
+        return result &= other;
+    }
+
+    bitslice_u256 operator|(const bitslice_u256 &other) const {
+        bitslice_u256 result = *this;
+        return result |= other;
+    }
+
+    bitslice_u256 operator^(const bitslice_u256 &other) const {
+        bitslice_u256 result = *this;
+        return result ^= other;
+    }
+};
+
+/**
+ * @brief Packs up to 64 bytes of 0/1 into the bits of a word, byte k to bit k.
+ */
+uint64_t bitslice_pack(const uint8_t *bits, const std::size_t count) {
+    uint64_t packed = 0;
+    std::size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        uint64_t bytes;
+        std::memcpy(&bytes, bits + k, sizeof(bytes));
+        bytes &= 0x0101010101010101ull;
+        // Every byte lands in the top byte shifted by its index (little-endian load)
+        packed |= ((bytes * 0x0102040810204080ull) >> 56) << k;
+    }
+    for (; k < count; ++k) {
+        packed |= static_cast<uint64_t>(bits[k] & 0x1) << k;
+    }
+    return packed;
+}
+
+/**
+ * @brief Transposes a 64x64 bit matrix in place: bit c of row r moves to bit r of row c.
+ */
+void bitslice_transpose(uint64_t *rows) {
+    uint64_t mask = 0x00000000FFFFFFFFull;
+    for (std::size_t width = 32; width != 0; width >>= 1, mask ^= mask << width) {
+        for (std::size_t row = 0; row < 64; row = (row + width + 1) & ~width) {
+            const uint64_t swap = ((rows[row] >> width) ^ rows[row + width]) & mask;
+            rows[row] ^= swap << width;
+            rows[row + width] ^= swap;
+        }
+    }
+}
+
+/**
+ * @brief Lane access for the lane word types.
+ */
+template<typename Word>
+struct BitsliceLanes;
+
+template<>
+struct BitsliceLanes<uint64_t> {
+    static constexpr std::size_t count = 64;
+
+    static bool test(const uint64_t word, const std::size_t lane) {
+        return (word >> lane) & 0x1;
+    }
+
+    static void set(uint64_t &word, const std::size_t lane) {
+        word |= 1ull << lane;
+    }
+
+    static void clear(uint64_t &word, const std::size_t lane) {
+        word &= ~(1ull << lane);
+    }
+
+    static bool any_of(const uint64_t word) {
+        return word != 0;
+    }
+
+    static void set_part(uint64_t &word, const std::size_t, const uint64_t lanes) {
+        word = lanes;
+    }
+
+    /**
+     * @brief Calls on_lane(std::size_t) for every lane with its bit set.
+     */
+    template<typename Callback>
+    static void for_each(uint64_t word, Callback on_lane) {
+        for (; word != 0; word &= word - 1) {
+            on_lane(static_cast<std::size_t>(__builtin_ctzll(word)));
+        }
+    }
+};
+
+template<>
+struct BitsliceLanes<bitslice_u256> {
+    static constexpr std::size_t count = 256;
+
+    static bool test(const bitslice_u256 &word, const std::size_t lane) {
+        return (word.parts[lane / 64] >> (lane % 64)) & 0x1;
+    }
+
+    static void set(bitslice_u256 &word, const std::size_t lane) {
+        word.parts[lane / 64] |= 1ull << (lane % 64);
+    }
+
+    static void clear(bitslice_u256 &word, const std::size_t lane) {
+        word.parts[lane / 64] &= ~(1ull << (lane % 64));
+    }
+
+    static bool any_of(const bitslice_u256 &word) {
+        return (word.parts[0] | word.parts[1] | word.parts[2] | word.parts[3]) != 0;
+    }
+
+    /**
+     * @brief Sets lanes 64 * part .. 64 * part + 63.
+     */
+    static void set_part(bitslice_u256 &word, const std::size_t part, const uint64_t lanes) {
+        word.parts[part] = lanes;
+    }
+
+    template<typename Callback>
+    static void for_each(const bitslice_u256 &word, Callback on_lane) {
+        for (std::size_t part = 0; part < 4; ++part) {
+            for (uint64_t rest = word.parts[part]; rest != 0; rest &= rest - 1) {
+                on_lane(part * 64 + static_cast<std::size_t>(__builtin_ctzll(rest)));
+            }
+        }
+    }
+};
+
+/**
+ * @brief Block sync of up to BitsliceLanes<Word>::count streams, same state machine as BlockSync
+ * (acquire on A followed by B, burst correction once synced, drop after BLOCK_SYNC_MAX_BAD_BLOCKS).
+ */
+template<typename Word>
+class BitslicedBlockSync {
+private:
+    typedef BitsliceLanes<Word> Lanes;
+
+    struct Lane {
+        int block = 0;
+        bool group_valid = true;
+        int bad_blocks = 0;
+        RawGroup group;
+        BlockSyncCounters counters;
+    };
+
+    std::vector<Lane> lanes;
+
+    // History planes, newest bit at planes[head], bit of age k at planes[head + k] (stored twice, no wrap-around)
+    Word planes[2 * BITSLICE_HISTORY];
+    std::size_t head = 0;
+
+    uint32_t generator;                       // g(x) without x^10, = x^10 mod g
+    uint32_t leaving;                         // x^26 mod g, the bit leaving the window
+    Word syndrome[CRC_BITS];                  // Of the newest 26 bits
+    Word syndromes[BLOCK_ROW_SIZE][CRC_BITS]; // Of the last 26 steps, slot = step % 26
+    std::size_t slot = 0;
+
+    Word synced = Word();
+    Word boundaries[BLOCK_ROW_SIZE]; // Synced lanes completing a block at step % 26 == slot
+    Word expected[BLOCK_PARTS_COUNT]; // Lanes expecting offset A..D next
+    uint32_t offsets[BLOCK_PARTS_COUNT];
+
+    /**
+     * @brief Lanes whose syndrome equals the offset word.
+     */
+    static Word _match(const Word *syndrome, const uint32_t offset) {
+        Word match = ~Word();
+        for (int j = 0; j < CRC_BITS; ++j) {
+            match &= (offset >> j) & 0x1 ? syndrome[j] : ~syndrome[j];
+        }
+        return match;
+    }
+
+    /**
+     * @brief Raw 26-bit word of one lane, `age` bits back.
+     */
+    uint32_t _word(const std::size_t lane, const std::size_t age) const {
+        uint32_t word = 0;
+        for (int k = 0; k < BLOCK_ROW_SIZE; ++k) {
+            word |= static_cast<uint32_t>(Lanes::test(planes[head + age + k], lane)) << k;
+        }
+        return word;
+    }
+
+    void _expect(const std::size_t lane, const int block) {
+        for (int offset = OFFSET_A; offset < BLOCK_PARTS_COUNT; ++offset) {
+            Lanes::clear(expected[offset], lane);
+        }
+        Lanes::set(expected[block], lane);
+        lanes[lane].block = block;
+    }
+
+    /**
+     * @brief A block of a synced lane is complete.
+     */
+    template<typename Callback>
+    void _block(const std::size_t lane, const bool valid, const bool version_b, Callback on_group) {
+        Lane &state = lanes[lane];
+        uint32_t word = this->_word(lane, 0);
+        if (valid) {
+            state.bad_blocks = 0;
+        } else if (version_b) {
+            state.bad_blocks = 0;
+            state.counters.version_b++;
+        } else if (block_code.correct_burst(word, offsets[state.block])) {
+            state.bad_blocks = 0;
+            state.counters.corrected_burst++;
+        } else {
+            state.group_valid = false;
+            state.counters.bad++;
+            if (++state.bad_blocks >= BLOCK_SYNC_MAX_BAD_BLOCKS) {
+                Lanes::clear(synced, lane);
+                Lanes::clear(boundaries[slot], lane);
+                state.counters.sync_losses++;
+                return;
+            }
+        }
+        state.group.words[state.block] = word;
+
+        if (state.block + 1 == BLOCK_PARTS_COUNT) {
+            if (state.group_valid) {
+                state.counters.groups++;
+                on_group(lane, static_cast<const RawGroup &>(state.group));
+            }
+            state.group_valid = true;
+            this->_expect(lane, OFFSET_A);
+        } else {
+            this->_expect(lane, state.block + 1);
+        }
+    }
+
+public:
+    /**
+     * @param lane_count Streams, at most BitsliceLanes<Word>::count
+     */
+    explicit BitslicedBlockSync(const std::size_t lane_count) : lanes(lane_count) {
+        for (auto &plane: planes) {
+            plane = Word();
+        }
+        for (auto &bit: syndrome) {
+            bit = Word();
+        }
+        for (auto &step: syndromes) {
+            for (auto &bit: step) {
+                bit = Word();
+            }
+        }
+        for (auto &boundary: boundaries) {
+            boundary = Word();
+        }
+        for (auto &lanes_expecting: expected) {
+            lanes_expecting = Word();
+        }
+        generator = block_code.bit_syndromes[CRC_BITS];
+        const uint32_t last = block_code.bit_syndromes[BLOCK_ROW_SIZE - 1];
+        leaving = ((last << 1) & ((1u << CRC_BITS) - 1)) ^ ((last >> (CRC_BITS - 1)) & 0x1 ? generator : 0);
+        for (int offset = OFFSET_A; offset < BLOCK_PARTS_COUNT; ++offset) {
+            offsets[offset] = OFFSET_WORDS[offset];
+        }
+    }
+
+    std::size_t lane_count() const {
+        return lanes.size();
+    }
+
+    const BlockSyncCounters &counters(const std::size_t lane) const {
+        return lanes[lane].counters;
+    }
+
+    /**
+     * @brief Adds one bit to every lane (lane k = bit k of `bits`), calls on_group(std::size_t lane, const RawGroup &)
+     * for every complete group whose blocks all have the expected offsets.
+     */
+    template<typename Callback>
+    void push(const Word bits, Callback on_group) {
+        const Word out = planes[head + BLOCK_ROW_SIZE - 1];
+        head = head == 0 ? BITSLICE_HISTORY - 1 : head - 1;
+        planes[head] = bits;
+        planes[head + BITSLICE_HISTORY] = bits;
+
+        const Word top = syndrome[CRC_BITS - 1];
+        for (int j = CRC_BITS - 1; j > 0; --j) {
+            Word value = syndrome[j - 1];
+            if ((generator >> j) & 0x1) {
+                value ^= top;
+            }
+            if ((leaving >> j) & 0x1) {
+                value ^= out;
+            }
+            syndrome[j] = value;
+        }
+        syndrome[0] = bits ^ ((generator & 0x1) ? top : Word()) ^ ((leaving & 0x1) ? out : Word());
+
+        // Syndrome of the previous block of every lane was computed 26 steps ago, in this slot
+        Word *previous = syndromes[slot];
+        const Word acquired = ~synced & _match(previous, offsets[OFFSET_A]) & _match(syndrome, offsets[OFFSET_B]);
+        const Word due = synced & boundaries[slot];
+
+        if (Lanes::any_of(due)) {
+            Word valid = Word();
+            for (int offset = OFFSET_A; offset < BLOCK_PARTS_COUNT; ++offset) {
+                valid |= expected[offset] & _match(syndrome, offsets[offset]);
+            }
+            const Word version_b = expected[OFFSET_C] & _match(syndrome, BLOCK_SYNC_OFFSET_C_PRIME);
+            Lanes::for_each(due, [&](const std::size_t lane) {
+                if (lane < lanes.size()) {
+                    this->_block(lane, Lanes::test(valid, lane), Lanes::test(version_b, lane), on_group);
+                }
+            });
+        }
+
+        Lanes::for_each(acquired, [&](const std::size_t lane) {
+            if (lane >= lanes.size()) {
+                return;
+            }
+            Lane &state = lanes[lane];
+            state.group.words[OFFSET_A] = this->_word(lane, BLOCK_ROW_SIZE);
+            state.group.words[OFFSET_B] = this->_word(lane, 0);
+            state.group_valid = true;
+            state.bad_blocks = 0;
+            this->_expect(lane, OFFSET_C);
+            Lanes::set(synced, lane);
+            Lanes::set(boundaries[slot], lane);
+        });
+
+        for (int j = 0; j < CRC_BITS; ++j) {
+            previous[j] = syndrome[j];
+        }
+        slot = slot + 1 == BLOCK_ROW_SIZE ? 0 : slot + 1;
+    }
+
+    /**
+     * @brief Transposes `steps` bits of every stream (one bit per byte, streams[lane][step]) into lane words
+     * and pushes them. Blocks of 64 steps x 64 lanes are transposed as bit matrices.
+     */
+    template<typename Callback>
+    void push_streams(const std::vector<const uint8_t *> &streams, const std::size_t steps, Callback on_group) {
+        Word words[64];
+        uint64_t matrix[64];
+        for (std::size_t base = 0; base < steps; base += 64) {
+            const std::size_t count = std::min<std::size_t>(64, steps - base);
+            for (std::size_t step = 0; step < count; ++step) {
+                words[step] = Word();
+            }
+            for (std::size_t part = 0; part * 64 < streams.size(); ++part) {
+                for (std::size_t row = 0; row < 64; ++row) {
+                    const std::size_t lane = part * 64 + row;
+                    matrix[row] = lane < streams.size() ? bitslice_pack(streams[lane] + base, count) : 0;
+                }
+                bitslice_transpose(matrix);
+                for (std::size_t step = 0; step < count; ++step) {
+                    Lanes::set_part(words[step], part, matrix[step]);
+                }
+            }
+            for (std::size_t step = 0; step < count; ++step) {
+                this->push(words[step], on_group);
+            }
+        }
+    }
+};
+
+
+#endif
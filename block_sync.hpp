@@ -0,0 +1,307 @@
+/**
+ * @file block_sync.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Group synchronization of a continuous bitstream that does not start on a group boundary
+ * (bits recovered by the demodulator). Sync is acquired on a block with offset A followed by
+ * a block with offset B, then every 26 bits the next expected offset is checked.
+ *
+ * Once synced, a block with the wrong syndrome is corrected as a burst of up to BLOCK_BURST_MAX
+ * bits (syndrome table). For soft input, combinations of its least reliable bits are flipped
+ * first (Chase) and the most likely of the corrections is kept.
+ */
+#ifndef BLOCK_SYNC_HPP
+#define BLOCK_SYNC_HPP
+
+#include <cstdint>
+#include <ostream>
+
+#define BLOCK_SYNC_OFFSET_C_PRIME (OFFSET_WORD_C_PRIME) // Block C of version B groups
+#define BLOCK_SYNC_MAX_BAD_BLOCKS (8)             // Bad blocks in a row before the sync is dropped
+#define BLOCK_BURST_MAX (5)                       // Longest error burst the code corrects
+#define BLOCK_CHASE_BITS_DEFAULT (5)              // Least reliable bits flipped by Chase (2^bits - 1 candidates)
+#define BLOCK_CHASE_BITS_MAX (10)
+#define BLOCK_CHASE_MAX_COST (1)                  // Flipped reliability accepted, in mean bit reliabilities of the block
+
+/**
+ * @brief Syndrome tables of the block code. The syndrome is linear in the received word, so it is
+ * the XOR of per-byte table entries, and flipping bits changes it by the XOR of their single-bit syndromes.
+ */
+class BlockCode {
+private:
+    uint16_t byte_syndromes[4][256];
+
+    static uint16_t _bit_syndrome(const int bit) {
+        // Bits 0-9 are the checkword itself, data bit d contributes the checkword of x^d
+        if (bit < CRC_BITS) {
+            return static_cast<uint16_t>(1u << bit);
+        }
+        return crc_checkword(static_cast<uint16_t>(1u << (bit - CRC_BITS)));
+    }
+
+public:
+    uint16_t bit_syndromes[BLOCK_ROW_SIZE]; // Bit 0 = last bit of the checkword
+    uint32_t bursts[1 << CRC_BITS];         // Error syndrome -> burst error pattern, 0 = not a short burst
+
+    BlockCode() {
+        for (int bit = 0; bit < BLOCK_ROW_SIZE; ++bit) {
+            bit_syndromes[bit] = _bit_syndrome(bit);
+        }
+        for (int byte = 0; byte < 4; ++byte) {
+            for (uint32_t value = 0; value < 256; ++value) {
+                uint16_t syndrome = 0;
+                for (int bit = 0; bit < 8 && byte * 8 + bit < BLOCK_ROW_SIZE; ++bit) {
+                    syndrome ^= (value >> bit) & 0x1 ? bit_syndromes[byte * 8 + bit] : 0;
+                }
+                byte_syndromes[byte][value] = syndrome;
+            }
+        }
+
+        // Shorter bursts first, so each syndrome keeps the most likely pattern
+        std::fill(bursts, bursts + (1 << CRC_BITS), 0);
+        for (int length = 1; length <= BLOCK_BURST_MAX; ++length) {
+            const uint32_t inner = length > 2 ? 1u << (length - 2) : 1;
+            for (uint32_t middle = 0; middle < inner; ++middle) {
+                const uint32_t burst = length == 1 ? 1 : (1u << (length - 1)) | (middle << 1) | 1;
+                for (int shift = 0; shift + length <= BLOCK_ROW_SIZE; ++shift) {
+                    const uint32_t pattern = burst << shift;
+                    const uint32_t syndrome = syndrome_of(pattern);
+                    if (bursts[syndrome] == 0) {
+                        bursts[syndrome] = pattern;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Syndrome of a raw 26-bit block word, equals the offset word of the block if it has no errors.
+     */
+    uint32_t syndrome_of(const uint32_t word) const {
+        return byte_syndromes[0][word & 0xFF] ^ byte_syndromes[1][(word >> 8) & 0xFF]
+               ^ byte_syndromes[2][(word >> 16) & 0xFF] ^ byte_syndromes[3][(word >> 24) & 0x3];
+    }
+
+    /**
+     * @brief Corrects a burst of up to BLOCK_BURST_MAX bits.
+     *
+     * @return true if the word was corrected to the expected offset
+     */
+    bool correct_burst(uint32_t &word, const uint32_t expected_offset) const {
+        const uint32_t pattern = bursts[syndrome_of(word) ^ expected_offset];
+        if (pattern == 0) {
+            return false;
+        }
+        word ^= pattern;
+        return true;
+    }
+
+    /**
+     * @brief Chase decoding: flips every combination (including none) of the `bits` least reliable positions,
+     * burst-corrects the result and keeps the candidate matching the expected offset whose flipped bits
+     * have the lowest total reliability. Candidates flipping more than BLOCK_CHASE_MAX_COST mean bit
+     * reliabilities are rejected, otherwise noise (e.g. after a fade) would always "correct" to some block.
+     *
+     * @param reliability Reliability of every bit of the word, index = bit position
+     * @return true if the word was corrected to the expected offset
+     */
+    bool correct_chase(uint32_t &word, const uint8_t *reliability, const uint32_t expected_offset, const int bits) const {
+        // Least reliable positions, selection of the `bits` smallest
+        int positions[BLOCK_CHASE_BITS_MAX];
+        uint32_t taken = 0;
+        for (int k = 0; k < bits; ++k) {
+            int least = -1;
+            for (int bit = 0; bit < BLOCK_ROW_SIZE; ++bit) {
+                if (!((taken >> bit) & 0x1) && (least < 0 || reliability[bit] < reliability[least])) {
+                    least = bit;
+                }
+            }
+            positions[k] = least;
+            taken |= 1u << least;
+        }
+
+        const uint32_t error = syndrome_of(word) ^ expected_offset;
+        uint32_t best_flips = 0;
+        uint32_t best_cost = UINT32_MAX;
+        for (uint32_t combination = 0; combination < (1u << bits); ++combination) {
+            uint32_t syndrome = error;
+            uint32_t flips = 0;
+            for (int k = 0; k < bits; ++k) {
+                if ((combination >> k) & 0x1) {
+                    syndrome ^= bit_syndromes[positions[k]];
+                    flips |= 1u << positions[k];
+                }
+            }
+            if (syndrome != 0) {
+                if (bursts[syndrome] == 0) {
+                    continue;
+                }
+                flips ^= bursts[syndrome];
+            }
+
+            uint32_t cost = 0;
+            for (uint32_t rest = flips; rest != 0; rest &= rest - 1) {
+                cost += reliability[__builtin_ctz(rest)];
+            }
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_flips = flips;
+            }
+        }
+        uint32_t total = 0;
+        for (int bit = 0; bit < BLOCK_ROW_SIZE; ++bit) {
+            total += reliability[bit];
+        }
+        if (best_cost == UINT32_MAX || best_cost * BLOCK_ROW_SIZE > total * BLOCK_CHASE_MAX_COST) {
+            return false;
+        }
+        word ^= best_flips;
+        return true;
+    }
+};
+
+const BlockCode block_code;
+
+/**
+ * @brief Syndrome of a raw 26-bit block word, equals the offset word of the block if it has no errors.
+ */
+uint32_t block_syndrome(const uint32_t word) {
+    return block_code.syndrome_of(word);
+}
+
+struct BlockSyncCounters {
+    uint64_t groups = 0;
+    uint64_t bad = 0;          // Blocks with a syndrome other than the expected offset, not correctable
+    uint64_t version_b = 0;    // Groups with block C'
+    uint64_t sync_losses = 0;
+    uint64_t corrected_burst = 0;
+    uint64_t corrected_chase = 0;
+
+    void report(std::ostream &out) const {
+        out << "Block sync: " << groups << " groups, " << bad << " bad blocks, " << version_b
+            << " version B groups, " << sync_losses << " sync losses, " << corrected_burst << " burst corrected, "
+            << corrected_chase << " Chase corrected blocks" << std::endl;
+    }
+};
+
+class BlockSync : public BlockSyncCounters {
+private:
+    uint64_t history = 0; // Last received bits, newest in bit 0
+    uint8_t reliability[BLOCK_ROW_SIZE] = {}; // Of the bits of the current block, index = bit position
+    bool synced = false;
+    int bits_in_block = 0;
+    int block = 0;        // Offset index expected next
+    bool group_valid = true;
+    int bad_blocks = 0;
+    int chase_bits;
+    RawGroup group;
+
+    static uint32_t _offset(const int index) {
+        return OFFSET_WORDS[index];
+    }
+
+    /**
+     * @brief Corrects a block that does not match its offset: Chase for soft input (its candidates include
+     * the plain burst correction), burst correction for hard input.
+     */
+    bool _correct(uint32_t &word, const uint32_t offset, const bool soft) {
+        if (soft && chase_bits > 0) {
+            if (block_code.correct_chase(word, reliability, offset, chase_bits)) {
+                corrected_chase++;
+                return true;
+            }
+            return false;
+        }
+        if (block_code.correct_burst(word, offset)) {
+            corrected_burst++;
+            return true;
+        }
+        return false;
+    }
+
+    template<typename Callback>
+    void _push(const int bit, const bool soft, Callback on_group) {
+        history = (history << 1) | static_cast<uint64_t>(bit & 0x1);
+
+        if (!synced) {
+            // Offset A in the older block and offset B in the newer one
+            const auto word_A = static_cast<uint32_t>((history >> BLOCK_ROW_SIZE) & ((1u << BLOCK_ROW_SIZE) - 1));
+            const auto word_B = static_cast<uint32_t>(history & ((1u << BLOCK_ROW_SIZE) - 1));
+            if (block_syndrome(word_B) == _offset(OFFSET_B) && block_syndrome(word_A) == _offset(OFFSET_A)) {
+                synced = true;
+                group.words[OFFSET_A] = word_A;
+                group.words[OFFSET_B] = word_B;
+                group_valid = true;
+                block = OFFSET_C;
+                bits_in_block = 0;
+                bad_blocks = 0;
+            }
+            return;
+        }
+
+        if (++bits_in_block < BLOCK_ROW_SIZE) {
+            return;
+        }
+        bits_in_block = 0;
+
+        auto word = static_cast<uint32_t>(history & ((1u << BLOCK_ROW_SIZE) - 1));
+        const uint32_t syndrome = block_syndrome(word);
+        if (syndrome == _offset(block)) {
+            bad_blocks = 0;
+        } else if (block == OFFSET_C && syndrome == BLOCK_SYNC_OFFSET_C_PRIME) {
+            bad_blocks = 0;
+            version_b++;
+        } else if (this->_correct(word, _offset(block), soft)) {
+            bad_blocks = 0;
+        } else {
+            group_valid = false;
+            bad++;
+            if (++bad_blocks >= BLOCK_SYNC_MAX_BAD_BLOCKS) {
+                synced = false;
+                sync_losses++;
+                return;
+            }
+        }
+        group.words[block] = word;
+
+        if (++block == BLOCK_PARTS_COUNT) {
+            if (group_valid) {
+                groups++;
+                on_group(group);
+            }
+            block = OFFSET_A;
+            group_valid = true;
+        }
+    }
+
+public:
+    /**
+     * @param chase_bits Least reliable bits tried by the Chase correction of soft input, 0 = off
+     */
+    explicit BlockSync(const int chase_bits = BLOCK_CHASE_BITS_DEFAULT) : chase_bits(chase_bits) {
+    }
+
+    /**
+     * @brief Adds one bit, calls on_group(const RawGroup &) for every complete group whose blocks all have
+     * the expected offsets A, B, C (or C') and D (after correction).
+     */
+    template<typename Callback>
+    void push(const int bit, Callback on_group) {
+        this->_push(bit, false, on_group);
+    }
+
+    /**
+     * @brief Adds one soft bit: the sign is the bit (positive = 1), the magnitude its reliability (0 = erasure).
+     */
+    template<typename Callback>
+    void push_soft(const int8_t value, Callback on_group) {
+        // Bit position in the block word: the first bit of a block ends up as bit 25
+        reliability[BLOCK_ROW_SIZE - 1 - (synced ? bits_in_block : 0)] = static_cast<uint8_t>(value < 0 ? (value == INT8_MIN ? INT8_MAX : -value) : value);
+        this->_push(value > 0 ? 1 : 0, true, on_group);
+    }
+
+};
+
+
+#endif
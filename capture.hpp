@@ -0,0 +1,268 @@
+/**
+ * @file capture.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Seekable capture container for synchronized groups.
+ *
+ * Layout:
+ *   CaptureFileHeader
+ *   chunk 0 .. chunk N-1      CAPTURE_CHUNK_GROUPS x CaptureRecord each (last one may be shorter)
+ *   CaptureChunkIndex[N]      offsets, time range, PI and group type bitmaps per chunk
+ *   CaptureFooter             locates the index, written last
+ *
+ * The reader maps the file and consults only the index to find chunks that
+ * may contain matching groups, the other chunks are never touched.
+ */
+#ifndef CAPTURE_HPP
+#define CAPTURE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "group_layout.hpp"
+#include "mapped_file.hpp"
+
+#define CAPTURE_MAGIC "RDSCAPT1"
+#define CAPTURE_INDEX_MAGIC "RDSINDX1"
+#define CAPTURE_VERSION (1)
+#define CAPTURE_CHUNK_GROUPS (4096)
+#define CAPTURE_PI_BITMAP_BITS (256)
+
+struct CaptureFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t chunk_groups;
+};
+
+/**
+ * @brief One synchronized group: information words of blocks A, B, C, D and the time it was received.
+ */
+struct CaptureRecord {
+    uint64_t timestamp; // Microseconds since the Unix epoch
+    uint16_t words[BLOCK_PARTS_COUNT];
+};
+
+struct CaptureChunkIndex {
+    uint64_t offset;     // File offset of the first record
+    uint32_t count;      // Records in the chunk
+    uint32_t group_types; // Bit (type * 2 + version) for every group type present
+    uint64_t first_timestamp;
+    uint64_t last_timestamp;
+    uint64_t program_ids[CAPTURE_PI_BITMAP_BITS / 64]; // Hashed PI bitmap
+};
+
+struct CaptureFooter {
+    uint64_t index_offset;
+    uint32_t chunk_count;
+    uint32_t version;
+    char magic[8];
+};
+
+static_assert(sizeof(CaptureRecord) == 16, "CaptureRecord is part of the file format");
+static_assert(sizeof(CaptureChunkIndex) == 64, "CaptureChunkIndex is part of the file format");
+
+/**
+ * @brief Wall-clock time in microseconds since the Unix epoch.
+ */
+uint64_t capture_now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Bit of the PI in the per-chunk PI bitmap.
+ */
+uint32_t capture_pi_bit(const uint16_t program_id) {
+    return ((static_cast<uint32_t>(program_id) * 40503u) >> 8) & (CAPTURE_PI_BITMAP_BITS - 1);
+}
+
+/**
+ * @brief Group type bit (type * 2 + version) of block B.
+ */
+uint32_t capture_group_type_bit(const uint16_t block_B) {
+    return static_cast<uint32_t>(group_type_index(block_B));
+}
+
+class CaptureWriter {
+private:
+    std::ofstream file;
+    std::vector<CaptureRecord> chunk;
+    std::vector<CaptureChunkIndex> index;
+    uint64_t offset = sizeof(CaptureFileHeader);
+    bool closed = false;
+
+    void _flush_chunk() {
+        if (chunk.empty()) {
+            return;
+        }
+
+        CaptureChunkIndex entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.offset = offset;
+        entry.count = static_cast<uint32_t>(chunk.size());
+        entry.first_timestamp = chunk.front().timestamp;
+        entry.last_timestamp = chunk.front().timestamp;
+        for (const auto &record: chunk) {
+            const uint32_t pi_bit = capture_pi_bit(record.words[0]);
+            entry.program_ids[pi_bit / 64] |= 1ULL << (pi_bit % 64);
+            entry.group_types |= 1u << capture_group_type_bit(record.words[1]);
+            entry.first_timestamp = record.timestamp < entry.first_timestamp ? record.timestamp : entry.first_timestamp;
+            entry.last_timestamp = record.timestamp > entry.last_timestamp ? record.timestamp : entry.last_timestamp;
+        }
+
+        const auto bytes = chunk.size() * sizeof(CaptureRecord);
+        file.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(bytes));
+        offset += bytes;
+        index.push_back(entry);
+        chunk.clear();
+    }
+
+public:
+    explicit CaptureWriter(const std::string &path) : file(path, std::ios::binary | std::ios::trunc) {
+        if (!file) {
+            throw std::invalid_argument("Cannot create capture file: " + path);
+        }
+        CaptureFileHeader header;
+        std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+        header.version = CAPTURE_VERSION;
+        header.chunk_groups = CAPTURE_CHUNK_GROUPS;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        chunk.reserve(CAPTURE_CHUNK_GROUPS);
+    }
+
+    ~CaptureWriter() {
+        close();
+    }
+
+    void write(const uint64_t timestamp, const uint16_t *words) {
+        CaptureRecord record;
+        record.timestamp = timestamp;
+        std::memcpy(record.words, words, sizeof(record.words));
+        chunk.push_back(record);
+        if (chunk.size() == CAPTURE_CHUNK_GROUPS) {
+            _flush_chunk();
+        }
+    }
+
+    /**
+     * @brief Writes the last chunk, the index and the footer. Without it the file is not readable.
+     */
+    void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        _flush_chunk();
+
+        CaptureFooter footer;
+        footer.index_offset = offset;
+        footer.chunk_count = static_cast<uint32_t>(index.size());
+        footer.version = CAPTURE_VERSION;
+        std::memcpy(footer.magic, CAPTURE_INDEX_MAGIC, sizeof(footer.magic));
+        file.write(reinterpret_cast<const char *>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(CaptureChunkIndex)));
+        file.write(reinterpret_cast<const char *>(&footer), sizeof(footer));
+        file.close();
+    }
+};
+
+/**
+ * @brief Chunk-level predicate derived from the query, evaluated on the index only.
+ */
+class CaptureQuery {
+public:
+    uint64_t from = 0;
+    uint64_t to = UINT64_MAX;
+    uint32_t group_types = 0xFFFFFFFF;
+    bool any_program_id = true;
+    uint64_t program_ids[CAPTURE_PI_BITMAP_BITS / 64] = {0};
+
+    void add_program_id(const uint16_t program_id) {
+        any_program_id = false;
+        const uint32_t pi_bit = capture_pi_bit(program_id);
+        program_ids[pi_bit / 64] |= 1ULL << (pi_bit % 64);
+    }
+
+    bool may_match(const CaptureChunkIndex &entry) const {
+        if (entry.last_timestamp < from || entry.first_timestamp > to || (entry.group_types & group_types) == 0) {
+            return false;
+        }
+        if (any_program_id) {
+            return true;
+        }
+        for (int i = 0; i < CAPTURE_PI_BITMAP_BITS / 64; ++i) {
+            if (entry.program_ids[i] & program_ids[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+class CaptureReader {
+private:
+    MappedFile file;
+    const CaptureChunkIndex *index = nullptr;
+    uint32_t chunk_count = 0;
+
+public:
+    uint64_t chunks_scanned = 0;
+    uint64_t chunks_skipped = 0;
+
+    explicit CaptureReader(const std::string &path) : file(path) {
+        const auto size = file.length();
+        if (size < sizeof(CaptureFileHeader) + sizeof(CaptureFooter)
+            || std::memcmp(file.bytes(), CAPTURE_MAGIC, 8) != 0) {
+            throw std::invalid_argument("Not a capture file: " + path);
+        }
+
+        CaptureFooter footer;
+        std::memcpy(&footer, file.bytes() + size - sizeof(CaptureFooter), sizeof(footer));
+        if (std::memcmp(footer.magic, CAPTURE_INDEX_MAGIC, 8) != 0 || footer.version != CAPTURE_VERSION) {
+            throw std::invalid_argument("Capture file has no index (not closed properly?): " + path);
+        }
+        if (footer.index_offset + footer.chunk_count * sizeof(CaptureChunkIndex) + sizeof(CaptureFooter) != size) {
+            throw std::invalid_argument("Capture file index is corrupted: " + path);
+        }
+
+        index = reinterpret_cast<const CaptureChunkIndex *>(file.bytes() + footer.index_offset);
+        chunk_count = footer.chunk_count;
+        for (uint32_t i = 0; i < chunk_count; ++i) {
+            if (index[i].offset + index[i].count * sizeof(CaptureRecord) > footer.index_offset) {
+                throw std::invalid_argument("Capture file index is corrupted: " + path);
+            }
+        }
+
+        // Queries jump between chunks, read-ahead of the whole file would be wasted
+        file.advise_random();
+    }
+
+    /**
+     * @brief Calls callback(const CaptureRecord &) for every record in the time range of chunks the query may match.
+     * Per-group filtering (exact PI, group type) is left to the caller.
+     */
+    template<typename Callback>
+    void for_each(const CaptureQuery &query, Callback callback) {
+        for (uint32_t i = 0; i < chunk_count; ++i) {
+            if (!query.may_match(index[i])) {
+                chunks_skipped++;
+                continue;
+            }
+            chunks_scanned++;
+            const auto records = reinterpret_cast<const CaptureRecord *>(file.bytes() + index[i].offset);
+            for (uint32_t j = 0; j < index[i].count; ++j) {
+                if (records[j].timestamp >= query.from && records[j].timestamp <= query.to) {
+                    callback(records[j]);
+                }
+            }
+        }
+    }
+};
+
+
+#endif
@@ -0,0 +1,225 @@
+/**
+ * @file channelizer.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Wideband IQ front end: splits an IQ recording into FM channels on a regular grid
+ * with an FFT polyphase filter bank and FM-demodulates the channels to MPX.
+ *
+ * For M = sample rate / channel spacing channels and output decimation D, output m of
+ * channel k is the input filtered by the prototype lowpass h shifted to k * fs / M:
+ *
+ *   y_k(m) = e^(-2 pi i k m D / M) * FFT_k( u ),  u[r] = sum_p h[p M + r] x[m D + p M + r]
+ *
+ * The fold u costs one multiply-add per prototype tap and the M-point FFT is shared by
+ * all channels, so the cost per channel drops as more stations are decoded.
+ */
+#ifndef CHANNELIZER_HPP
+#define CHANNELIZER_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fft.hpp"
+#include "mapped_file.hpp"
+
+#define CHANNELIZER_TAPS_PER_BRANCH (16)
+#define CHANNELIZER_PASSBAND (110000.0)   // Hz, one-sided passband of a channel
+#define CHANNELIZER_TARGET_RATE (250000)  // Hz, minimum channel output rate (FM deviation + RDS)
+#define CHANNELIZER_SPACING_DEFAULT (100000)
+#define FM_DEVIATION (75000.0)            // Hz
+#define IQ_CHUNK (65536)                  // IQ samples read at once
+#define IQ_DETECT_SECONDS (0.5)           // Recording scanned for active channels
+#define IQ_DETECT_THRESHOLD (10.0)        // Channel power over the noise floor to count as a station
+
+/**
+ * @brief dst[i] += a[i] * b[i]
+ */
+void mpx_multiply_accumulate(float *dst, const float *a, const float *b, const std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        mpx_v4f x, y, z;
+        std::memcpy(&x, a + i, sizeof(x));
+        std::memcpy(&y, b + i, sizeof(y));
+        std::memcpy(&z, dst + i, sizeof(z));
+        z += x * y;
+        std::memcpy(dst + i, &z, sizeof(z));
+    }
+    for (; i < count; ++i) {
+        dst[i] += a[i] * b[i];
+    }
+}
+
+enum class IqFormat {
+    CU8,  // Unsigned 8-bit I/Q pairs (RTL-SDR)
+    CS16, // Signed 16-bit little-endian I/Q pairs
+    CF32  // 32-bit float I/Q pairs
+};
+
+/**
+ * @brief Sequential reader of headerless interleaved IQ files.
+ */
+class IqReader {
+private:
+    MappedFile file;
+    IqFormat format;
+    std::size_t sample_size;
+    std::size_t samples;
+    std::size_t position = 0;
+
+public:
+    IqReader(const std::string &path, const IqFormat format) : file(path), format(format) {
+        sample_size = format == IqFormat::CU8 ? 2 : format == IqFormat::CS16 ? 4 : 8;
+        samples = file.length() / sample_size;
+        file.advise_sequential();
+    }
+
+    void rewind() {
+        position = 0;
+    }
+
+    /**
+     * @brief Reads up to `count` samples into separate I and Q arrays.
+     *
+     * @return Samples read, 0 at the end of the file
+     */
+    std::size_t read(float *i_out, float *q_out, const std::size_t count) {
+        const std::size_t n = samples - position < count ? samples - position : count;
+        const uint8_t *in = file.bytes() + position * sample_size;
+        for (std::size_t k = 0; k < n; ++k) {
+            if (format == IqFormat::CU8) {
+                i_out[k] = (in[2 * k] - 127.5f) / 128.0f;
+                q_out[k] = (in[2 * k + 1] - 127.5f) / 128.0f;
+            } else if (format == IqFormat::CS16) {
+                i_out[k] = static_cast<int16_t>(in[4 * k] | (in[4 * k + 1] << 8)) / 32768.0f;
+                q_out[k] = static_cast<int16_t>(in[4 * k + 2] | (in[4 * k + 3] << 8)) / 32768.0f;
+            } else {
+                std::memcpy(i_out + k, in + 8 * k, sizeof(float));
+                std::memcpy(q_out + k, in + 8 * k + 4, sizeof(float));
+            }
+        }
+        position += n;
+        return n;
+    }
+};
+
+class PolyphaseChannelizer {
+private:
+    std::size_t channels;   // M
+    std::size_t decimation; // D
+    std::vector<float> prototype;
+    Fft fft;
+    std::vector<std::complex<float>> rotations; // e^(-2 pi i j / M)
+
+    // Input history, separate I and Q so the fold is a plain multiply-add over floats
+    std::vector<float> history_i;
+    std::vector<float> history_q;
+    std::size_t consumed = 0; // Samples of the history already used as output positions
+    uint64_t output_index = 0;
+
+    std::vector<float> fold_i;
+    std::vector<float> fold_q;
+    std::vector<std::complex<float>> spectrum;
+
+    void _design_prototype(const double sample_rate) {
+        const std::size_t count = channels * CHANNELIZER_TAPS_PER_BRANCH;
+        prototype.resize(count);
+        const double cutoff = CHANNELIZER_PASSBAND / sample_rate;
+        double sum = 0;
+        for (std::size_t n = 0; n < count; ++n) {
+            const double m = static_cast<double>(n) - (count - 1) / 2.0;
+            const double sinc = m == 0 ? 2 * cutoff : std::sin(2 * M_PI * cutoff * m) / (M_PI * m);
+            const double window = 0.42 - 0.5 * std::cos(2 * M_PI * n / (count - 1)) + 0.08 * std::cos(4 * M_PI * n / (count - 1));
+            prototype[n] = static_cast<float>(sinc * window);
+            sum += prototype[n];
+        }
+        for (auto &tap: prototype) {
+            tap = static_cast<float>(tap / sum);
+        }
+    }
+
+public:
+    /**
+     * @param channels Number of channels M (sample rate / channel spacing)
+     * @param decimation Output decimation D
+     */
+    PolyphaseChannelizer(const double sample_rate, const std::size_t channels, const std::size_t decimation)
+            : channels(channels), decimation(decimation), fft(channels), rotations(channels), fold_i(channels), fold_q(channels), spectrum(channels) {
+        _design_prototype(sample_rate);
+        for (std::size_t j = 0; j < channels; ++j) {
+            const double angle = -2 * M_PI * static_cast<double>(j) / static_cast<double>(channels);
+            rotations[j] = std::complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+        }
+    }
+
+    /**
+     * @brief Channelizes a block of input, calls on_output(const std::complex<float> *spectrum) with all M channel
+     * samples for every D input samples.
+     */
+    template<typename Callback>
+    void process(const float *i_in, const float *q_in, const std::size_t count, Callback on_output) {
+        history_i.insert(history_i.end(), i_in, i_in + count);
+        history_q.insert(history_q.end(), q_in, q_in + count);
+
+        const std::size_t taps = prototype.size();
+        while (consumed + taps <= history_i.size()) {
+            std::fill(fold_i.begin(), fold_i.end(), 0.0f);
+            std::fill(fold_q.begin(), fold_q.end(), 0.0f);
+            for (std::size_t p = 0; p < taps; p += channels) {
+                mpx_multiply_accumulate(fold_i.data(), prototype.data() + p, history_i.data() + consumed + p, channels);
+                mpx_multiply_accumulate(fold_q.data(), prototype.data() + p, history_q.data() + consumed + p, channels);
+            }
+            for (std::size_t r = 0; r < channels; ++r) {
+                spectrum[r] = std::complex<float>(fold_i[r], fold_q[r]);
+            }
+            fft.forward(spectrum.data());
+
+            // Output time reference m D, a no-op when D is a multiple of M
+            const std::size_t shift = (output_index * decimation) % channels;
+            if (shift != 0) {
+                std::size_t rotation = 0; // k * shift mod M
+                for (std::size_t k = 1; k < channels; ++k) {
+                    rotation += shift;
+                    rotation -= rotation >= channels ? channels : 0;
+                    spectrum[k] = fft_multiply(spectrum[k], rotations[rotation]);
+                }
+            }
+            on_output(spectrum.data());
+
+            output_index++;
+            consumed += decimation;
+        }
+
+        // Drop input no later output needs
+        history_i.erase(history_i.begin(), history_i.begin() + static_cast<std::ptrdiff_t>(consumed));
+        history_q.erase(history_q.begin(), history_q.begin() + static_cast<std::ptrdiff_t>(consumed));
+        consumed = 0;
+    }
+};
+
+/**
+ * @brief FM discriminator, output 1.0 at the nominal 75 kHz deviation.
+ */
+class FmDemodulator {
+private:
+    std::complex<float> previous = std::complex<float>(1.0f, 0.0f);
+    float scale;
+
+public:
+    explicit FmDemodulator(const double sample_rate) : scale(static_cast<float>(sample_rate / (2 * M_PI * FM_DEVIATION))) {
+    }
+
+    void process(const std::complex<float> *in, float *out, const std::size_t count) {
+        for (std::size_t n = 0; n < count; ++n) {
+            out[n] = scale * std::arg(fft_multiply(in[n], std::conj(previous)));
+            previous = in[n];
+        }
+    }
+};
+
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file charset.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Conversion between the RDS basic character set (EBU Latin, G0 code table of IEC 62106) of PS/RT
+ * and UTF-8.
+ *
+ *   G0 -> UTF-8  256-entry table of code points
+ *   UTF-8 -> G0  perfect hash of the code points: one multiply, one probe, no collisions
+ *
+ * Both directions write into caller buffers, nothing is allocated.
+ */
+#ifndef CHARSET_HPP
+#define CHARSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#define G0_SPACE (0x20)
+#define G0_UTF8_MAX (3)                     // UTF-8 bytes of one G0 character (all are in the BMP)
+#define G0_REVERSE_BITS (9)
+#define G0_REVERSE_SIZE (1 << G0_REVERSE_BITS)
+#define G0_REVERSE_MULTIPLIER (0x645B2361u) // Found offline, G0ReverseTable checks it is collision-free
+
+/**
+ * @brief Code point of every G0 code, control codes (0x00 - 0x1F) and unassigned ones are shown as spaces.
+ */
+constexpr uint16_t G0_TO_UNICODE[256] = {
+        0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, // 0x00
+        0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020,
+        0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, // 0x10
+        0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020,
+        0x0020, 0x0021, 0x0022, 0x0023, 0x00A4, 0x0025, 0x0026, 0x0027, // 0x20
+        0x0028, 0x0029, 0x002A, 0x002B, 0x002C, 0x002D, 0x002E, 0x002F,
+        0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, // 0x30
+        0x0038, 0x0039, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F,
+        0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, // 0x40
+        0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D, 0x004E, 0x004F,
+        0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057, // 0x50
+        0x0058, 0x0059, 0x005A, 0x005B, 0x005C, 0x005D, 0x2015, 0x005F,
+        0x2016, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067, // 0x60
+        0x0068, 0x0069, 0x006A, 0x006B, 0x006C, 0x006D, 0x006E, 0x006F,
+        0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077, // 0x70
+        0x0078, 0x0079, 0x007A, 0x007B, 0x007C, 0x007D, 0x00AF, 0x0020,
+        0x00E1, 0x00E0, 0x00E9, 0x00E8, 0x00ED, 0x00EC, 0x00F3, 0x00F2, // 0x80
+        0x00FA, 0x00F9, 0x00D1, 0x00C7, 0x015E, 0x03B2, 0x00A1, 0x0132,
+        0x00E2, 0x00E4, 0x00EA, 0x00EB, 0x00EE, 0x00EF, 0x00F4, 0x00F6, // 0x90
+        0x00FB, 0x00FC, 0x00F1, 0x00E7, 0x015F, 0x011F, 0x0131, 0x0133,
+        0x00AA, 0x03B1, 0x00A9, 0x2030, 0x011E, 0x011B, 0x0148, 0x0151, // 0xA0
+        0x03C0, 0x20AC, 0x00A3, 0x0024, 0x2190, 0x2191, 0x2192, 0x2193,
+        0x00BA, 0x00B9, 0x00B2, 0x00B3, 0x00B1, 0x0130, 0x0144, 0x0171, // 0xB0
+        0x00B5, 0x00BF, 0x00F7, 0x00B0, 0x00BC, 0x00BD, 0x00BE, 0x00A7,
+        0x00C1, 0x00C0, 0x00C9, 0x00C8, 0x00CD, 0x00CC, 0x00D3, 0x00D2, // 0xC0
+        0x00DA, 0x00D9, 0x0158, 0x010C, 0x0160, 0x017D, 0x0110, 0x013F,
+        0x00C2, 0x00C4, 0x00CA, 0x00CB, 0x00CE, 0x00CF, 0x00D4, 0x00D6, // 0xD0
+        0x00DB, 0x00DC, 0x0159, 0x010D, 0x0161, 0x017E, 0x0111, 0x0140,
+        0x00C3, 0x00C5, 0x00C6, 0x0152, 0x0177, 0x00DD, 0x00D5, 0x00D8, // 0xE0
+        0x00DE, 0x014A, 0x0154, 0x0106, 0x015A, 0x0179, 0x0166, 0x00F0,
+        0x00E3, 0x00E5, 0x00E6, 0x0153, 0x0175, 0x00FD, 0x00F5, 0x00F8, // 0xF0
+        0x00FE, 0x014B, 0x0155, 0x0107, 0x015B, 0x017A, 0x0167, 0x0020
+};
+
+constexpr std::size_t g0_reverse_slot(const uint32_t code_point) {
+    return static_cast<uint32_t>(code_point * G0_REVERSE_MULTIPLIER) >> (32 - G0_REVERSE_BITS);
+}
+
+/**
+ * @brief Code point -> G0 code, built at compile time from G0_TO_UNICODE.
+ * Every code point has its own slot, a lookup compares the one slot it hashes to.
+ */
+struct G0ReverseTable {
+    uint16_t code_point[G0_REVERSE_SIZE] = {}; // 0 = empty slot
+    uint8_t code[G0_REVERSE_SIZE] = {};
+    bool perfect = true;
+
+    constexpr G0ReverseTable() {
+        for (int g0 = G0_SPACE; g0 < 256; ++g0) {
+            const uint16_t value = G0_TO_UNICODE[g0];
+            const std::size_t slot = g0_reverse_slot(value);
+            if (code_point[slot] == value) {
+                continue; // Space of the unassigned codes, the first one (0x20) is kept
+            }
+            perfect &= code_point[slot] == 0;
+            code_point[slot] = value;
+            code[slot] = static_cast<uint8_t>(g0);
+        }
+    }
+
+    /**
+     * @return The G0 code, -1 if the character has none
+     */
+    int lookup(const uint32_t value) const {
+        const std::size_t slot = g0_reverse_slot(value);
+        return value <= 0xFFFF && code_point[slot] == value && value != 0 ? code[slot] : -1;
+    }
+};
+
+constexpr G0ReverseTable G0_REVERSE{};
+static_assert(G0_REVERSE.perfect, "G0_REVERSE_MULTIPLIER must map the G0 code points without collisions");
+
+/**
+ * @brief Writes the UTF-8 form of G0 text.
+ *
+ * @param out At least size * G0_UTF8_MAX bytes
+ * @return Bytes written
+ */
+std::size_t g0_to_utf8(const char *text, const std::size_t size, char *out) {
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const uint16_t value = G0_TO_UNICODE[static_cast<uint8_t>(text[i])];
+        if (value < 0x80) {
+            out[length++] = static_cast<char>(value);
+        } else if (value < 0x800) {
+            out[length++] = static_cast<char>(0xC0 | (value >> 6));
+            out[length++] = static_cast<char>(0x80 | (value & 0x3F));
+        } else {
+            out[length++] = static_cast<char>(0xE0 | (value >> 12));
+            out[length++] = static_cast<char>(0x80 | ((value >> 6) & 0x3F));
+            out[length++] = static_cast<char>(0x80 | (value & 0x3F));
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Converts UTF-8 text to G0, characters beyond `capacity` are dropped.
+ *
+ * @return G0 characters written to out
+ * @throws std::invalid_argument if the text is not valid UTF-8 or has a character G0 cannot represent
+ */
+std::size_t utf8_to_g0(const char *text, char *out, const std::size_t capacity) {
+    std::size_t length = 0;
+    for (const auto *byte = reinterpret_cast<const uint8_t *>(text); *byte != 0 && length < capacity;) {
+        uint32_t value = *byte++;
+        int continuation = value < 0x80 ? 0 : (value & 0xE0) == 0xC0 ? 1 : (value & 0xF0) == 0xE0 ? 2 : -1;
+        if (continuation < 0) {
+            throw std::invalid_argument("Invalid UTF-8 text or a character outside of the RDS character set: " + std::string(text));
+        }
+        value &= 0x7Fu >> continuation;
+        for (; continuation > 0; --continuation) {
+            if ((*byte & 0xC0) != 0x80) {
+                throw std::invalid_argument("Invalid UTF-8 text: " + std::string(text));
+            }
+            value = (value << 6) | (*byte++ & 0x3F);
+        }
+
+        const int g0 = G0_REVERSE.lookup(value);
+        if (g0 < 0) {
+            throw std::invalid_argument("Character not in the RDS character set: " + std::string(text));
+        }
+        out[length++] = static_cast<char>(g0);
+    }
+    return length;
+}
+
+
+#endif
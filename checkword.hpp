@@ -0,0 +1,154 @@
+/**
+ * @file checkword.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Batch checkword computation: checkwords of arrays of 16-bit information words at once.
+ *
+ *   scalar - bit-serial division, the reference
+ *   table  - the compile-time byte tables of CRC_TABLE
+ *   clmul  - carry-less multiply (x86 PCLMULQDQ), Barrett reduction of two words per multiply
+ *
+ * checkwords() picks the fastest kernel the CPU supports on first use.
+ */
+#ifndef CHECKWORD_HPP
+#define CHECKWORD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "shared.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define CHECKWORD_HAS_CLMUL (1)
+#else
+#define CHECKWORD_HAS_CLMUL (0)
+#endif
+
+#define CHECKWORD_MASK ((1u << CRC_BITS) - 1)
+
+enum class CheckwordKernel {
+    AUTO,
+    SCALAR,
+    TABLE,
+    CLMUL
+};
+
+/**
+ * @brief Reference: checkword of one information word, offset word added.
+ */
+uint16_t checkword_scalar(const uint16_t info, const uint16_t offset) {
+    return static_cast<uint16_t>(crc_checkword(info) ^ offset);
+}
+
+void checkwords_scalar(const uint16_t *info, const uint16_t *offsets, uint16_t *out, const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = checkword_scalar(info[i], offsets[i]);
+    }
+}
+
+void checkwords_table(const uint16_t *info, const uint16_t *offsets, uint16_t *out, const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<uint16_t>(CRC_TABLE.checkword(info[i]) ^ offsets[i]);
+    }
+}
+
+#if CHECKWORD_HAS_CLMUL
+
+/**
+ * @brief Barrett reduction: for m = info * x^10 (degree < 26), q = floor(info * mu / x^16) with
+ * mu = floor(x^26 / g) is the exact quotient, the checkword is the low 10 bits of m + q * g.
+ * Two information words share a multiply, one in each 32-bit half of the operand (products stay
+ * below 32 bits, so the halves do not mix).
+ */
+__attribute__((target("pclmul,sse2")))
+void checkwords_clmul(const uint16_t *info, const uint16_t *offsets, uint16_t *out, const std::size_t count) {
+    // mu = floor(x^26 / g), degree 16
+    uint32_t remainder = 1u << 26;
+    uint32_t mu = 0;
+    for (int i = 26; i >= CRC_BITS; --i) {
+        if (remainder & (1u << i)) {
+            remainder ^= CRC_POLYNOMIAL << (i - CRC_BITS);
+            mu |= 1u << (i - CRC_BITS);
+        }
+    }
+    const __m128i mu_vector = _mm_cvtsi32_si128(static_cast<int>(mu));
+    const __m128i g_vector = _mm_cvtsi32_si128(CRC_POLYNOMIAL);
+
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const uint64_t pair = static_cast<uint64_t>(info[i]) | (static_cast<uint64_t>(info[i + 1]) << 32);
+        const __m128i t = _mm_cvtsi64_si128(static_cast<long long>(pair));
+
+        // q per half: (info * mu) >> 16, 16 bits
+        const __m128i product = _mm_clmulepi64_si128(t, mu_vector, 0x00);
+        const __m128i q = _mm_and_si128(_mm_srli_epi64(product, 16), _mm_set_epi64x(0, 0x0000FFFF0000FFFFll));
+
+        // q * g per half (degree < 26), its low 10 bits are the checkword (m has none there)
+        const auto reduced = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_clmulepi64_si128(q, g_vector, 0x00)));
+        out[i] = static_cast<uint16_t>((reduced & CHECKWORD_MASK) ^ offsets[i]);
+        out[i + 1] = static_cast<uint16_t>(((reduced >> 32) & CHECKWORD_MASK) ^ offsets[i + 1]);
+    }
+    checkwords_table(info + i, offsets + i, out + i, count - i);
+}
+
+#endif
+
+/**
+ * @brief The kernel used by checkwords(), AUTO = fastest supported.
+ *
+ * @throws std::invalid_argument if the kernel is not supported by this CPU
+ */
+CheckwordKernel checkword_select(const CheckwordKernel kernel = CheckwordKernel::AUTO) {
+#if CHECKWORD_HAS_CLMUL
+    const bool has_clmul = __builtin_cpu_supports("pclmul");
+#else
+    const bool has_clmul = false;
+#endif
+    static CheckwordKernel selected = has_clmul ? CheckwordKernel::CLMUL : CheckwordKernel::TABLE;
+    if (kernel == CheckwordKernel::CLMUL && !has_clmul) {
+        throw std::invalid_argument("Carry-less multiply is not supported by this CPU");
+    }
+    if (kernel != CheckwordKernel::AUTO) {
+        selected = kernel;
+    }
+    return selected;
+}
+
+const char *checkword_kernel_name(const CheckwordKernel kernel) {
+    switch (kernel) {
+        case CheckwordKernel::SCALAR:
+            return "scalar";
+        case CheckwordKernel::TABLE:
+            return "table";
+        case CheckwordKernel::CLMUL:
+            return "clmul";
+        default:
+            return "auto";
+    }
+}
+
+/**
+ * @brief out[i] = checkword of info[i] with offsets[i] added, for `count` words.
+ */
+void checkwords(const uint16_t *info, const uint16_t *offsets, uint16_t *out, const std::size_t count) {
+    switch (checkword_select()) {
+        case CheckwordKernel::SCALAR:
+            checkwords_scalar(info, offsets, out, count);
+            break;
+#if CHECKWORD_HAS_CLMUL
+        case CheckwordKernel::CLMUL:
+            checkwords_clmul(info, offsets, out, count);
+            break;
+#endif
+        default:
+            checkwords_table(info, offsets, out, count);
+            break;
+    }
+}
+
+
+#endif
@@ -0,0 +1,343 @@
+/**
+ * @file compress.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Compressed format for archived ASCII bitstreams ('0'/'1' characters as
+ * printed by rds_encoder). Carousels repeat the same groups all the time, so
+ * every group is coded against a model shared by compressor and decompressor:
+ *
+ *   0x00..0xEF  dictionary reference, the group equals dictionary slot N
+ *   0xF0        literal, 13 bytes of raw group bits follow (4 x 26 bits)
+ *   0xF1        next segment: the last group of type T (1 byte) with the segment
+ *               address incremented, C and D information words follow (4 bytes),
+ *               checkwords are recomputed
+ *   0xF2        clock tick: the last 4A group advanced by one minute
+ *   0xF3        line break in the original text
+ *
+ * Delta ops are only emitted when they reproduce the received bits exactly,
+ * so groups with corrupted checkwords survive the round trip as literals.
+ */
+#ifndef COMPRESS_HPP
+#define COMPRESS_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "group_filter.hpp"
+
+#define RDSZ_MAGIC "RDSZ"
+#define RDSZ_VERSION (1)
+#define RDSZ_HEADER_SIZE (5)
+#define RDSZ_DICTIONARY_SIZE (240)
+#define RDSZ_OP_LITERAL (0xF0)
+#define RDSZ_OP_NEXT_SEGMENT (0xF1)
+#define RDSZ_OP_CLOCK_TICK (0xF2)
+#define RDSZ_OP_NEWLINE (0xF3)
+#define RDSZ_LITERAL_SIZE (13)
+#define RDSZ_TYPE_CLOCK (8) // Group type index (type * 2 + version) of 4A
+#define RDSZ_BUFFER_SIZE (1 << 20) // Output is written in chunks of this size
+
+/**
+ * @brief The four raw 26-bit block words (information word + checkword) of a group.
+ */
+struct RawGroup {
+    uint32_t words[BLOCK_PARTS_COUNT];
+
+    bool operator==(const RawGroup &other) const {
+        return words[0] == other.words[0] && words[1] == other.words[1]
+               && words[2] == other.words[2] && words[3] == other.words[3];
+    }
+};
+
+/**
+ * @brief Raw 26-bit block word from an information word and the offset of its position.
+ */
+uint32_t raw_block_word(const uint16_t data, const uint16_t offset) {
+    return (static_cast<uint32_t>(data) << CRC_BITS) | static_cast<uint32_t>(CRC_TABLE.checkword(data) ^ offset);
+}
+
+/**
+ * @brief Reads `count` bits starting at bit `start` of a big-endian byte array.
+ */
+uint32_t read_bits(const uint8_t *bytes, const std::size_t start, const int count) {
+    uint64_t value = 0;
+    const std::size_t first = start / 8;
+    const std::size_t last = (start + count - 1) / 8;
+    for (std::size_t i = first; i <= last; ++i) {
+        value = (value << 8) | bytes[i];
+    }
+    const int tail = static_cast<int>((last + 1) * 8 - (start + count));
+    return static_cast<uint32_t>((value >> tail) & ((1ULL << count) - 1));
+}
+
+/**
+ * @brief Parses one group of SIZE_GROUP ASCII characters.
+ *
+ * @return false if the characters are not all '0'/'1'
+ */
+bool parse_ascii_group(const char *text, RawGroup &group) {
+    uint8_t bytes[RDSZ_LITERAL_SIZE];
+    for (int i = 0; i < RDSZ_LITERAL_SIZE; ++i) {
+        if (!ascii_to_byte(text + i * 8, bytes[i])) {
+            return false;
+        }
+    }
+    for (int block = 0; block < BLOCK_PARTS_COUNT; ++block) {
+        group.words[block] = read_bits(bytes, block * BLOCK_ROW_SIZE, BLOCK_ROW_SIZE);
+    }
+    return true;
+}
+
+/**
+ * @brief Appends the group as SIZE_GROUP ASCII characters.
+ */
+void format_ascii_group(const RawGroup &group, std::string &out) {
+    for (int block = 0; block < BLOCK_PARTS_COUNT; ++block) {
+        for (int bit = BLOCK_ROW_SIZE - 1; bit >= 0; --bit) {
+            out.push_back(static_cast<char>('0' + ((group.words[block] >> bit) & 0x1)));
+        }
+    }
+}
+
+/**
+ * @brief Model shared by compressor and decompressor, both update it identically after every group.
+ */
+class GroupModel {
+private:
+    RawGroup dictionary[RDSZ_DICTIONARY_SIZE] = {};
+    bool dictionary_used[RDSZ_DICTIONARY_SIZE] = {false};
+    RawGroup last_by_type[GROUP_TYPE_COUNT] = {};
+    bool has_last[GROUP_TYPE_COUNT] = {false};
+
+    static uint16_t _data(const uint32_t word) {
+        return static_cast<uint16_t>(word >> CRC_BITS);
+    }
+
+public:
+    static int type_index(const RawGroup &group) {
+        return GroupFilter::group_type_index(_data(group.words[1]));
+    }
+
+    static int slot(const RawGroup &group) {
+        uint64_t hash = (static_cast<uint64_t>(group.words[0]) << 26 | group.words[1]) * 0x9E3779B97F4A7C15ULL;
+        hash ^= (static_cast<uint64_t>(group.words[2]) << 26 | group.words[3]) * 0xC2B2AE3D27D4EB4FULL;
+        return static_cast<int>((hash >> 32) % RDSZ_DICTIONARY_SIZE);
+    }
+
+    bool lookup(const int index, RawGroup &group) const {
+        if (!dictionary_used[index]) {
+            return false;
+        }
+        group = dictionary[index];
+        return true;
+    }
+
+    /**
+     * @brief Last group of the type with the segment address incremented, C and D replaced.
+     * Only group types 0A/0B (2-bit) and 2A/2B (4-bit segment address) have a segment address.
+     */
+    bool next_segment(const int type, const uint16_t data_C, const uint16_t data_D, RawGroup &group) const {
+        if (type < 0 || type >= GROUP_TYPE_COUNT || !has_last[type]) {
+            return false;
+        }
+        int segment_bits;
+        if (type / 2 == 0) {
+            segment_bits = 2;
+        } else if (type / 2 == 2) {
+            segment_bits = 4;
+        } else {
+            return false;
+        }
+
+        const RawGroup &last = last_by_type[type];
+        const uint16_t mask = static_cast<uint16_t>((1 << segment_bits) - 1);
+        uint16_t block_B = _data(last.words[1]);
+        block_B = static_cast<uint16_t>((block_B & ~mask) | ((block_B + 1) & mask));
+
+        group.words[0] = last.words[0];
+        group.words[1] = raw_block_word(block_B, OFFSET_WORDS[OFFSET_B]);
+        group.words[2] = raw_block_word(data_C, OFFSET_WORDS[OFFSET_C]);
+        group.words[3] = raw_block_word(data_D, OFFSET_WORDS[OFFSET_D]);
+        return true;
+    }
+
+    /**
+     * @brief Last 4A group (clock time) advanced by one minute, carrying into hour and Modified Julian Day.
+     */
+    bool clock_tick(RawGroup &group) const {
+        if (!has_last[RDSZ_TYPE_CLOCK]) {
+            return false;
+        }
+        const RawGroup &last = last_by_type[RDSZ_TYPE_CLOCK];
+        const uint16_t block_B = _data(last.words[1]);
+        const uint16_t block_C = _data(last.words[2]);
+        const uint16_t block_D = _data(last.words[3]);
+
+        uint32_t mjd = (static_cast<uint32_t>(block_B & 0x3) << 15) | (block_C >> 1);
+        uint32_t hour = static_cast<uint32_t>((block_C & 0x1) << 4) | (block_D >> 12);
+        uint32_t minute = (block_D >> 6) & 0x3F;
+        if (++minute == 60) {
+            minute = 0;
+            if (++hour == 24) {
+                hour = 0;
+                mjd = (mjd + 1) & 0x1FFFF;
+            }
+        }
+
+        const auto new_B = static_cast<uint16_t>((block_B & ~0x3) | (mjd >> 15));
+        const auto new_C = static_cast<uint16_t>(((mjd & 0x7FFF) << 1) | (hour >> 4));
+        const auto new_D = static_cast<uint16_t>(((hour & 0xF) << 12) | (minute << 6) | (block_D & 0x3F));
+        group.words[0] = last.words[0];
+        group.words[1] = raw_block_word(new_B, OFFSET_WORDS[OFFSET_B]);
+        group.words[2] = raw_block_word(new_C, OFFSET_WORDS[OFFSET_C]);
+        group.words[3] = raw_block_word(new_D, OFFSET_WORDS[OFFSET_D]);
+        return true;
+    }
+
+    void update(const RawGroup &group) {
+        const int index = slot(group);
+        dictionary[index] = group;
+        dictionary_used[index] = true;
+        const int type = type_index(group);
+        last_by_type[type] = group;
+        has_last[type] = true;
+    }
+};
+
+class GroupCompressor {
+private:
+    GroupModel model;
+
+public:
+    uint64_t groups = 0;
+    uint64_t references = 0;
+    uint64_t deltas = 0;
+    uint64_t literals = 0;
+
+    static void write_header(std::vector<uint8_t> &out) {
+        out.insert(out.end(), RDSZ_MAGIC, RDSZ_MAGIC + 4);
+        out.push_back(RDSZ_VERSION);
+    }
+
+    void group(const RawGroup &group, std::vector<uint8_t> &out) {
+        groups++;
+        const int index = GroupModel::slot(group);
+        RawGroup candidate;
+
+        if (model.lookup(index, candidate) && candidate == group) {
+            out.push_back(static_cast<uint8_t>(index));
+            references++;
+        } else if (model.clock_tick(candidate) && candidate == group) {
+            out.push_back(RDSZ_OP_CLOCK_TICK);
+            deltas++;
+        } else if (model.next_segment(GroupModel::type_index(group), static_cast<uint16_t>(group.words[2] >> CRC_BITS),
+                                      static_cast<uint16_t>(group.words[3] >> CRC_BITS), candidate) && candidate == group) {
+            out.push_back(RDSZ_OP_NEXT_SEGMENT);
+            out.push_back(static_cast<uint8_t>(GroupModel::type_index(group)));
+            for (int block = 2; block < BLOCK_PARTS_COUNT; ++block) {
+                out.push_back(static_cast<uint8_t>(group.words[block] >> (CRC_BITS + 8)));
+                out.push_back(static_cast<uint8_t>(group.words[block] >> CRC_BITS));
+            }
+            deltas++;
+        } else {
+            // 104 bits packed big-endian into 13 bytes
+            out.push_back(RDSZ_OP_LITERAL);
+            uint8_t bytes[RDSZ_LITERAL_SIZE] = {0};
+            for (int bit = 0; bit < SIZE_GROUP; ++bit) {
+                const uint32_t word = group.words[bit / BLOCK_ROW_SIZE];
+                const uint32_t value = (word >> (BLOCK_ROW_SIZE - 1 - bit % BLOCK_ROW_SIZE)) & 0x1;
+                bytes[bit / 8] = static_cast<uint8_t>(bytes[bit / 8] | (value << (7 - bit % 8)));
+            }
+            out.insert(out.end(), bytes, bytes + RDSZ_LITERAL_SIZE);
+            literals++;
+        }
+        model.update(group);
+    }
+
+    void newline(std::vector<uint8_t> &out) {
+        out.push_back(RDSZ_OP_NEWLINE);
+    }
+};
+
+class GroupDecompressor {
+private:
+    GroupModel model;
+    const uint8_t *position;
+    const uint8_t *end;
+
+    void _need(const std::size_t bytes) const {
+        if (static_cast<std::size_t>(end - position) < bytes) {
+            throw std::invalid_argument("Compressed stream is truncated.");
+        }
+    }
+
+public:
+    enum class Item {
+        GROUP,
+        NEWLINE,
+        END
+    };
+
+    GroupDecompressor(const uint8_t *data, const std::size_t size) : position(data), end(data + size) {
+        if (size < RDSZ_HEADER_SIZE || std::memcmp(data, RDSZ_MAGIC, 4) != 0) {
+            throw std::invalid_argument("Not a compressed RDS stream.");
+        }
+        if (data[4] != RDSZ_VERSION) {
+            throw std::invalid_argument("Unsupported compressed stream version " + std::to_string(data[4]));
+        }
+        position += RDSZ_HEADER_SIZE;
+    }
+
+    /**
+     * @brief Offset of the next op from the start of the stream.
+     */
+    std::size_t offset(const uint8_t *data) const {
+        return static_cast<std::size_t>(position - data);
+    }
+
+    Item next(RawGroup &group) {
+        if (position == end) {
+            return Item::END;
+        }
+
+        const uint8_t op = *position++;
+        if (op < RDSZ_DICTIONARY_SIZE) {
+            if (!model.lookup(op, group)) {
+                throw std::invalid_argument("Compressed stream references an empty dictionary slot.");
+            }
+        } else if (op == RDSZ_OP_LITERAL) {
+            _need(RDSZ_LITERAL_SIZE);
+            for (int block = 0; block < BLOCK_PARTS_COUNT; ++block) {
+                group.words[block] = read_bits(position, block * BLOCK_ROW_SIZE, BLOCK_ROW_SIZE);
+            }
+            position += RDSZ_LITERAL_SIZE;
+        } else if (op == RDSZ_OP_NEXT_SEGMENT) {
+            _need(5);
+            const int type = position[0];
+            const auto data_C = static_cast<uint16_t>((position[1] << 8) | position[2]);
+            const auto data_D = static_cast<uint16_t>((position[3] << 8) | position[4]);
+            position += 5;
+            if (!model.next_segment(type, data_C, data_D, group)) {
+                throw std::invalid_argument("Compressed stream has a segment delta without a base group.");
+            }
+        } else if (op == RDSZ_OP_CLOCK_TICK) {
+            if (!model.clock_tick(group)) {
+                throw std::invalid_argument("Compressed stream has a clock delta without a base group.");
+            }
+        } else if (op == RDSZ_OP_NEWLINE) {
+            return Item::NEWLINE;
+        } else {
+            throw std::invalid_argument("Invalid op in compressed stream: " + std::to_string(op));
+        }
+
+        model.update(group);
+        return Item::GROUP;
+    }
+};
+
+
+#endif
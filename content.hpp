@@ -0,0 +1,141 @@
+/**
+ * @file content.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Content the encoder broadcasts for one station (0A and 2A fields), with PS/RT already in G0 codes,
+ * and the "KEY=value" updates of the live mode.
+ */
+#ifndef CONTENT_HPP
+#define CONTENT_HPP
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "af.hpp"
+#include "charset.hpp"
+#include "group_layout.hpp"
+
+#define CONTENT_PROGRAM_TYPE_MAX (31)
+
+struct EncoderContent {
+    uint16_t program_id = 0;
+    uint8_t program_type = 0;
+    bool traffic_program = false;
+    bool traffic_announcement = false;
+    bool music_speech = false;
+    bool ab_flag = false;
+    std::vector<uint8_t> frequencies; // AF codes
+    std::string program_service = std::string(Group0A::segments * Group0A::chars_per_segment, G0_SPACE);
+    std::string radio_text;           // Whole segments, ends with Group2A::end_of_text if shorter than 64
+
+    /**
+     * @brief Program Service in G0 from UTF-8, padded with spaces to 8 characters.
+     *
+     * @throws std::invalid_argument
+     */
+    static std::string to_program_service(const char *text) {
+        std::string program_service(Group0A::segments * Group0A::chars_per_segment, G0_SPACE);
+        utf8_to_g0(text, &program_service[0], program_service.size());
+        return program_service;
+    }
+
+    /**
+     * @brief Radio Text in G0 from UTF-8, cut to 64 characters. Shorter text ends with the end of text marker
+     * and is padded with spaces to whole segments.
+     *
+     * @throws std::invalid_argument
+     */
+    static std::string to_radio_text(const char *text) {
+        std::string radio_text(Group2A::segments * Group2A::chars_per_segment, G0_SPACE);
+        std::size_t length = utf8_to_g0(text, &radio_text[0], radio_text.size());
+        if (length < radio_text.size()) {
+            radio_text[length++] = Group2A::end_of_text;
+        }
+        radio_text.resize((length + Group2A::chars_per_segment - 1) / Group2A::chars_per_segment * Group2A::chars_per_segment);
+        return radio_text;
+    }
+
+    /**
+     * @brief AF codes from comma separated MHz ("104.5,98.0"), 1 - 7 frequencies.
+     *
+     * @throws std::invalid_argument
+     */
+    static std::vector<uint8_t> to_frequencies(const std::string &text) {
+        std::vector<uint8_t> frequencies;
+        std::stringstream ss(text);
+        std::string token;
+        while (std::getline(ss, token, ',')) {
+            frequencies.push_back(af_parse_fm(token));
+        }
+
+        // A method A list: count code and the frequencies in block C of the four 0A groups
+        if (frequencies.empty() || frequencies.size() > Group0A::segments * 2 - 1) {
+            throw std::invalid_argument("Expected 1 - " + std::to_string(Group0A::segments * 2 - 1) + " alternative frequencies");
+        }
+        return frequencies;
+    }
+
+    /**
+     * @brief Applies one update line: PS=, RT=, AF=, PTY=, TP=, TA= or MS=. A new Radio Text toggles the A/B flag,
+     * so receivers drop the old one.
+     *
+     * @return true if the content changed
+     * @throws std::invalid_argument if the line is not a valid update
+     */
+    bool update(const std::string &line) {
+        const std::size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            throw std::invalid_argument("Expected KEY=value, got: " + line);
+        }
+        const std::string key = line.substr(0, separator);
+        const std::string value = line.substr(separator + 1);
+
+        if (key == "PS") {
+            return _set(program_service, to_program_service(value.c_str()));
+        } else if (key == "RT") {
+            const bool changed = _set(radio_text, to_radio_text(value.c_str()));
+            ab_flag ^= changed;
+            return changed;
+        } else if (key == "AF") {
+            return _set(frequencies, to_frequencies(value));
+        } else if (key == "PTY") {
+            std::size_t end = 0;
+            unsigned long type = 0;
+            try {
+                type = std::stoul(value, &end);
+            } catch (const std::logic_error &) {
+                end = 0;
+            }
+            if (value.empty() || value[0] < '0' || value[0] > '9' || end != value.size() || type > CONTENT_PROGRAM_TYPE_MAX) {
+                throw std::invalid_argument("Program type must be 0 - " + std::to_string(CONTENT_PROGRAM_TYPE_MAX) + ", got: " + value);
+            }
+            return _set(program_type, static_cast<uint8_t>(type));
+        }
+
+        bool *flag = key == "TP" ? &traffic_program : key == "TA" ? &traffic_announcement : key == "MS" ? &music_speech : nullptr;
+        if (flag == nullptr) {
+            throw std::invalid_argument("Unknown key: " + key + ". Expected PS, RT, AF, PTY, TP, TA or MS");
+        }
+        if (value != "0" && value != "1") {
+            throw std::invalid_argument(key + " must be 0 or 1, got: " + value);
+        }
+        return _set(*flag, value == "1");
+    }
+
+private:
+    template<typename T>
+    static bool _set(T &field, const T &value) {
+        if (field == value) {
+            return false;
+        }
+        field = value;
+        return true;
+    }
+};
+
+
+#endif
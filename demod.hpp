@@ -0,0 +1,203 @@
+/**
+ * @file demod.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * RDS demodulator from MPX samples to data bits:
+ *
+ *   57 kHz NCO mix -> lowpass FIR + decimation to ~16 samples per bit
+ *   -> Costas loop (corrects NCO phase/frequency from the decimated I/Q)
+ *   -> biphase matched filter -> Gardner timing recovery -> bit decisions
+ *   -> differential decoding
+ *
+ * The carrier is recovered by the Costas loop alone, recordings without a pilot
+ * (e.g. rds_encoder -mpx output) decode the same way as full multiplex signals.
+ */
+#ifndef DEMOD_HPP
+#define DEMOD_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#define DEMOD_SAMPLES_PER_BIT (16)   // Target rate after decimation
+#define DEMOD_CUTOFF (2800.0)        // Hz, lowpass cutoff of the baseband
+#define DEMOD_TRANSITION (2400.0)    // Hz, lowpass transition band
+#define DEMOD_NCO_BITS (12)          // Size of the NCO sine table (2^bits)
+#define DEMOD_BUFFER (8192)          // Mixed samples kept before the history is compacted
+#define DEMOD_COSTAS_ALPHA (0.02)    // Costas loop proportional gain (rad)
+#define DEMOD_COSTAS_BETA (0.0002)   // Costas loop integral gain (rad per decimated sample)
+#define DEMOD_TIMING_GAIN (0.02)     // Gardner loop gain (samples)
+
+class MpxDemodulator {
+private:
+    uint32_t sample_rate;
+    int decimation;
+    double samples_per_bit; // At the decimated rate
+
+    std::vector<float> taps;
+    std::vector<float> mixed_i;
+    std::vector<float> mixed_q;
+    int decimation_counter = 0;
+
+    // NCO, phase in cycles
+    std::vector<float> sine;
+    double phase = 0;
+    double step;
+    double frequency_correction = 0; // Cycles per input sample
+
+    // Matched filter input and output at the decimated rate
+    std::vector<float> baseband;
+    std::vector<float> matched;
+    uint64_t matched_base = 0; // Absolute index of matched[0]
+    int template_length;
+    float matched_level = 1e-6f;
+
+    // Timing
+    double strobe;
+    float previous_strobe_value = 0;
+    int previous_decision = 0;
+
+    float _matched_at(const double position) const {
+        const auto index = static_cast<uint64_t>(position);
+        const double fraction = position - static_cast<double>(index);
+        const float a = matched[index - matched_base];
+        const float b = matched[index + 1 - matched_base];
+        return static_cast<float>(a + (b - a) * fraction);
+    }
+
+    void _design_lowpass() {
+        // Windowed sinc (Hamming), length from the transition band
+        auto count = static_cast<int>(3.3 * sample_rate / DEMOD_TRANSITION);
+        count |= 1;
+        taps.resize(count);
+        const double cutoff = DEMOD_CUTOFF / sample_rate;
+        double sum = 0;
+        for (int n = 0; n < count; ++n) {
+            const double m = n - (count - 1) / 2.0;
+            const double sinc = m == 0 ? 2 * cutoff : std::sin(2 * M_PI * cutoff * m) / (M_PI * m);
+            const double window = 0.54 - 0.46 * std::cos(2 * M_PI * n / (count - 1));
+            taps[n] = static_cast<float>(sinc * window);
+            sum += taps[n];
+        }
+        for (auto &tap: taps) {
+            tap = static_cast<float>(tap / sum);
+        }
+    }
+
+    /**
+     * @brief One decimated I/Q sample: carrier loop, matched filter and, when due, a bit decision.
+     */
+    template<typename Callback>
+    void _decimated(const float i, const float q, Callback on_bit) {
+        //////////////////////////
+        /// Carrier recovery (Costas loop)
+        //////////////////////////
+        // Decision-directed error, normalized to [-1, 1] so the loop does not depend on the signal level
+        const double magnitude = std::fabs(i) + std::fabs(q);
+        const double error = magnitude > 0 ? (i > 0 ? q : -q) / magnitude : 0;
+        frequency_correction += DEMOD_COSTAS_BETA * error / (2 * M_PI) / decimation;
+        phase += DEMOD_COSTAS_ALPHA * error / (2 * M_PI);
+
+        //////////////////////////
+        /// Biphase matched filter: + first half of the bit, - second half
+        //////////////////////////
+        baseband.push_back(i);
+        if (baseband.size() < static_cast<std::size_t>(template_length)) {
+            matched.push_back(0);
+        } else {
+            const float *window = baseband.data() + baseband.size() - template_length;
+            float value = 0;
+            for (int k = 0; k < template_length / 2; ++k) {
+                value += window[k] - window[k + template_length / 2];
+            }
+            matched.push_back(value);
+            baseband.erase(baseband.begin());
+        }
+        matched_level = 0.999f * matched_level + 0.001f * std::fabs(matched.back());
+
+        //////////////////////////
+        /// Timing recovery (Gardner) and decisions
+        //////////////////////////
+        const uint64_t newest = matched_base + matched.size() - 1;
+        while (strobe + 1 <= static_cast<double>(newest)) {
+            const float value = _matched_at(strobe);
+            const float middle = _matched_at(strobe - samples_per_bit / 2);
+            const double timing_error = middle * (previous_strobe_value - value) / (static_cast<double>(matched_level) * matched_level);
+            previous_strobe_value = value;
+
+            const int decision = value > 0 ? 1 : 0;
+            on_bit(decision ^ previous_decision);
+            previous_decision = decision;
+
+            double adjustment = DEMOD_TIMING_GAIN * timing_error;
+            adjustment = adjustment > samples_per_bit / 8 ? samples_per_bit / 8 : adjustment < -samples_per_bit / 8 ? -samples_per_bit / 8 : adjustment;
+            strobe += samples_per_bit + adjustment;
+        }
+
+        // Keep what the interpolation can still reach
+        const auto keep = static_cast<uint64_t>(strobe - samples_per_bit) - 1;
+        if (keep > matched_base + DEMOD_BUFFER) {
+            matched.erase(matched.begin(), matched.begin() + static_cast<std::ptrdiff_t>(keep - matched_base));
+            matched_base = keep;
+        }
+    }
+
+public:
+    /**
+     * @throws std::invalid_argument if the sample rate is out of range
+     */
+    explicit MpxDemodulator(const uint32_t sample_rate) : sample_rate(sample_rate) {
+        if (sample_rate < MPX_SAMPLE_RATE_MIN || sample_rate > MPX_SAMPLE_RATE_MAX) {
+            throw std::invalid_argument("Sample rate must be between " + std::to_string(MPX_SAMPLE_RATE_MIN) + " and " + std::to_string(MPX_SAMPLE_RATE_MAX) + " Hz");
+        }
+        decimation = static_cast<int>(sample_rate / (BIT_RATE * DEMOD_SAMPLES_PER_BIT));
+        samples_per_bit = sample_rate / BIT_RATE / decimation;
+        template_length = static_cast<int>(samples_per_bit + 0.5) & ~1;
+        strobe = 2 * samples_per_bit;
+        step = static_cast<double>(MPX_CARRIER) / sample_rate;
+
+        _design_lowpass();
+        mixed_i.assign(taps.size() - 1, 0.0f);
+        mixed_q.assign(taps.size() - 1, 0.0f);
+        mixed_i.reserve(DEMOD_BUFFER + taps.size());
+        mixed_q.reserve(DEMOD_BUFFER + taps.size());
+
+        sine.resize(1 << DEMOD_NCO_BITS);
+        for (std::size_t n = 0; n < sine.size(); ++n) {
+            sine[n] = static_cast<float>(std::sin(2 * M_PI * static_cast<double>(n) / sine.size()));
+        }
+    }
+
+    /**
+     * @brief Demodulates a block of samples, calls on_bit(int) for every recovered data bit.
+     */
+    template<typename Callback>
+    void process(const float *samples, const std::size_t count, Callback on_bit) {
+        const std::size_t mask = sine.size() - 1;
+        const std::size_t quarter = sine.size() / 4;
+        for (std::size_t n = 0; n < count; ++n) {
+            const auto index = static_cast<std::size_t>(phase * sine.size()) & mask;
+            mixed_i.push_back(samples[n] * sine[(index + quarter) & mask]);
+            mixed_q.push_back(-samples[n] * sine[index]);
+            phase += step + frequency_correction;
+            phase -= std::floor(phase);
+
+            if (++decimation_counter == decimation) {
+                decimation_counter = 0;
+                const std::size_t start = mixed_i.size() - taps.size();
+                const float i = mpx_dot(mixed_i.data() + start, taps.data(), taps.size());
+                const float q = mpx_dot(mixed_q.data() + start, taps.data(), taps.size());
+                _decimated(i, q, on_bit);
+            }
+
+            if (mixed_i.size() >= DEMOD_BUFFER + taps.size()) {
+                mixed_i.erase(mixed_i.begin(), mixed_i.end() - static_cast<std::ptrdiff_t>(taps.size() - 1));
+                mixed_q.erase(mixed_q.begin(), mixed_q.end() - static_cast<std::ptrdiff_t>(taps.size() - 1));
+            }
+        }
+    }
+};
+
+
+#endif
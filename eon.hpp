@@ -0,0 +1,150 @@
+/**
+ * @file eon.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Enhanced Other Networks (EON, groups 14A/14B): cross-references between a tuned station and the
+ * other networks (ON) it announces.
+ *
+ * Every (tuned PI, other PI) link is one entry of a fixed-capacity StationTable, so a group updates its
+ * link with one hash and a short probe, independent of the number of stations and links, and memory
+ * stays the same however many networks are announced.
+ */
+#ifndef EON_HPP
+#define EON_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "af.hpp"
+#include "group_layout.hpp"
+#include "station_table.hpp"
+
+#define EON_LINKS_PER_STATION (4)  // Link slots per station slot (-stc)
+#define EON_MAPPED_MAX (8)       // Mapped frequency pairs kept per link
+
+/**
+ * @brief Tuned frequency of the tuned network and the frequency of the other network it maps to.
+ */
+struct EonMappedFrequency {
+    uint8_t tuned;
+    uint16_t mapped; // Channel as in af.hpp (AF_CHANNEL_LFMF for variant 9)
+};
+
+/**
+ * @brief What the tuned station announced about one other network.
+ */
+struct EonEntry {
+    uint16_t tuned_pi = 0;
+    uint16_t other_pi = 0;
+
+    // Program Service of the ON (variants 0 - 3), one bit per received segment
+    char program_service[Group14A::ps_segments * Group14A::chars_per_segment];
+    uint8_t program_service_segments = 0;
+    bool has_program_service = false;
+
+    uint8_t tp = 0;
+    uint8_t ta = 0;
+    uint8_t pty = 0;
+    bool has_pty = false;
+
+    // AF list of the ON (variant 4)
+    AfAssembler af;
+
+    // Mapped frequencies (variants 5 - 9)
+    EonMappedFrequency mapped[EON_MAPPED_MAX];
+    uint8_t mapped_count = 0;
+
+    // Linkage information (variant 12) and Program Item Number (variant 14)
+    uint16_t linkage = 0;
+    bool has_linkage = false;
+    uint16_t pin = 0;
+    bool has_pin = false;
+
+    // Content changed since the last emitted 14A record
+    bool changed = true;
+
+    EonEntry() {
+        std::memset(program_service, ' ', sizeof(program_service));
+    }
+
+    /**
+     * @return true if the pair was new or mapped the tuned frequency elsewhere
+     */
+    bool map(const uint8_t tuned, const uint16_t channel) {
+        for (int i = 0; i < mapped_count; ++i) {
+            if (mapped[i].tuned == tuned) {
+                const bool changed_pair = mapped[i].mapped != channel;
+                mapped[i].mapped = channel;
+                return changed_pair;
+            }
+        }
+        if (mapped_count == EON_MAPPED_MAX) {
+            return false;
+        }
+        mapped[mapped_count++] = EonMappedFrequency{tuned, channel};
+        return true;
+    }
+};
+
+/**
+ * @brief EON links, keyed by (tuned PI, other PI), in a fixed-capacity slab: once it is full the CLOCK hand
+ * evicts a link that was not updated recently, so a band scan does not grow the table.
+ */
+class EonTable {
+private:
+    StationTable<EonEntry, uint32_t> links;
+
+    static uint32_t _key(const uint16_t tuned_pi, const uint16_t other_pi) {
+        return (static_cast<uint32_t>(tuned_pi) << 16) | other_pi;
+    }
+
+public:
+    explicit EonTable(const std::size_t capacity = STATION_TABLE_DEFAULT_CAPACITY * EON_LINKS_PER_STATION) : links(capacity) {
+    }
+
+    /**
+     * @brief Drops all links and allocates the slab for `capacity` of them.
+     */
+    void allocate(const std::size_t capacity) {
+        links.allocate(capacity);
+    }
+
+    /**
+     * @brief The link, created empty if the tuned station did not announce the other network before
+     * (or the link was evicted since).
+     */
+    EonEntry &at(const uint16_t tuned_pi, const uint16_t other_pi) {
+        EonEntry &entry = links.at(_key(tuned_pi, other_pi), [](EonEntry &) {
+        });
+        entry.tuned_pi = tuned_pi;
+        entry.other_pi = other_pi;
+        return entry;
+    }
+
+    /**
+     * @return The link, nullptr if it is not known
+     */
+    const EonEntry *find(const uint16_t tuned_pi, const uint16_t other_pi) {
+        return links.find(_key(tuned_pi, other_pi));
+    }
+
+    /**
+     * @brief Number of links.
+     */
+    std::size_t size() const {
+        return links.size();
+    }
+
+    std::size_t capacity() const {
+        return links.capacity();
+    }
+
+    uint64_t evictions() const {
+        return links.evictions;
+    }
+};
+
+
+#endif
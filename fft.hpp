@@ -0,0 +1,134 @@
+/**
+ * @file fft.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Mixed-radix complex FFT for the small, not necessarily power-of-two sizes of the
+ * channelizer (sample rate / channel spacing, e.g. 24 for 2.4 MHz and 100 kHz).
+ */
+#ifndef FFT_HPP
+#define FFT_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Complex product without the NaN/infinity recovery of operator* (a libm call per product).
+ */
+inline std::complex<float> fft_multiply(const std::complex<float> a, const std::complex<float> b) {
+    return std::complex<float>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+class Fft {
+private:
+    struct Stage {
+        std::size_t radix;  // p
+        std::size_t length; // n = p * m, transforms of this length are produced by the stage
+    };
+
+    std::size_t size;
+    std::vector<Stage> stages;                 // Innermost first
+    std::vector<std::size_t> permutation;      // Input index of every leaf (mixed-radix digit reversal)
+    std::vector<std::complex<float>> twiddles; // Per stage, k, u and q >= 1, in the order the butterflies use them
+    std::vector<std::complex<float>> scratch;
+
+    /**
+     * @brief Leaf order of the recursive decimation in time: output position `out` holds input `in`.
+     */
+    void _permute(const std::size_t in, const std::size_t out, const std::size_t n, const std::size_t stride,
+                  const std::vector<std::size_t> &factors, const std::size_t level) {
+        if (n == 1) {
+            permutation[out] = in;
+            return;
+        }
+        const std::size_t p = factors[level];
+        for (std::size_t q = 0; q < p; ++q) {
+            _permute(in + q * stride, out + q * (n / p), n / p, stride * p, factors, level + 1);
+        }
+    }
+
+public:
+    /**
+     * @throws std::invalid_argument if the size has a prime factor over 16
+     */
+    explicit Fft(const std::size_t size) : size(size), permutation(size), scratch(size) {
+        std::vector<std::size_t> factors;
+        std::size_t rest = size;
+        for (std::size_t p = 2; rest > 1; ++p) {
+            while (rest % p == 0) {
+                if (p > 16) {
+                    throw std::invalid_argument("FFT size " + std::to_string(size) + " has a prime factor over 16");
+                }
+                factors.push_back(p);
+                rest /= p;
+            }
+        }
+        _permute(0, 0, size, 1, factors, 0);
+
+        std::size_t length = 1;
+        for (auto factor = factors.rbegin(); factor != factors.rend(); ++factor) {
+            length *= *factor;
+            stages.push_back(Stage{*factor, length});
+
+            // Radix-p butterfly twiddles e^(-2 pi i q index / n)
+            const std::size_t m = length / *factor;
+            for (std::size_t k = 0; k < m; ++k) {
+                for (std::size_t u = 0; u < *factor; ++u) {
+                    for (std::size_t q = 1; q < *factor; ++q) {
+                        const auto turn = static_cast<double>((q * (k + u * m)) % length) / static_cast<double>(length);
+                        twiddles.emplace_back(static_cast<float>(std::cos(-2 * M_PI * turn)), static_cast<float>(std::sin(-2 * M_PI * turn)));
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Forward transform of `size` values, in place.
+     */
+    void forward(std::complex<float> *data) {
+        scratch.assign(data, data + size);
+        for (std::size_t j = 0; j < size; ++j) {
+            data[j] = scratch[permutation[j]];
+        }
+
+        std::complex<float> values[16];
+        const std::complex<float> *twiddle_base = twiddles.data();
+        for (const auto &stage: stages) {
+            const std::size_t p = stage.radix;
+            const std::size_t m = stage.length / p;
+            for (std::size_t block = 0; block < size; block += stage.length) {
+                std::complex<float> *out = data + block;
+                const std::complex<float> *twiddle = twiddle_base;
+                if (p == 2) {
+                    // Butterfly a +- w b, the u = 1 twiddle is -w
+                    for (std::size_t k = 0; k < m; ++k, twiddle += 2) {
+                        const std::complex<float> a = out[k];
+                        const std::complex<float> b = fft_multiply(out[m + k], *twiddle);
+                        out[k] = a + b;
+                        out[m + k] = a - b;
+                    }
+                    continue;
+                }
+                for (std::size_t k = 0; k < m; ++k) {
+                    for (std::size_t q = 0; q < p; ++q) {
+                        values[q] = out[q * m + k];
+                    }
+                    for (std::size_t u = 0; u < p; ++u) {
+                        std::complex<float> sum = values[0];
+                        for (std::size_t q = 1; q < p; ++q) {
+                            sum += fft_multiply(values[q], *twiddle++);
+                        }
+                        out[k + u * m] = sum;
+                    }
+                }
+            }
+            twiddle_base += m * p * (p - 1);
+        }
+    }
+};
+
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file group_cache.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Small direct-mapped cache of already validated groups. Broadcasters repeat
+ * the same PS/RT groups over and over, an exact repeat of the raw block words
+ * does not need to be validated and extracted again.
+ */
+#ifndef GROUP_CACHE_HPP
+#define GROUP_CACHE_HPP
+
+#include <cstdint>
+#include <ostream>
+
+#define GROUP_CACHE_SIZE (512) // Must be a power of two
+
+/**
+ * @brief The four raw 26-bit block words of a group, in the order they were received.
+ */
+struct GroupKey {
+    uint32_t words[BLOCK_PARTS_COUNT];
+
+    bool operator==(const GroupKey &other) const {
+        return words[0] == other.words[0] && words[1] == other.words[1]
+               && words[2] == other.words[2] && words[3] == other.words[3];
+    }
+};
+
+/**
+ * @brief Validated group: information words already put in A, B, C, D order.
+ */
+struct CachedGroup {
+    GroupKey key;
+    uint16_t data[BLOCK_PARTS_COUNT];
+    bool used;
+};
+
+class GroupCache {
+private:
+    CachedGroup entries[GROUP_CACHE_SIZE] = {};
+
+    static uint32_t _slot(const GroupKey &key) {
+        uint64_t hash = (static_cast<uint64_t>(key.words[0]) << 26 | key.words[1]) * 0x9E3779B97F4A7C15ULL;
+        hash ^= (static_cast<uint64_t>(key.words[2]) << 26 | key.words[3]) * 0xC2B2AE3D27D4EB4FULL;
+        hash ^= hash >> 29;
+        return static_cast<uint32_t>(hash) & (GROUP_CACHE_SIZE - 1);
+    }
+
+public:
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t unchanged = 0; // Groups that did not change the station state
+
+    /**
+     * @brief Returns the cached group for an exact repeat of the raw words, nullptr otherwise.
+     */
+    const CachedGroup *lookup(const GroupKey &key) {
+        const CachedGroup &entry = entries[_slot(key)];
+        if (entry.used && entry.key == key) {
+            hits++;
+            return &entry;
+        }
+        misses++;
+        return nullptr;
+    }
+
+    /**
+     * @brief Stores a validated group, evicting whatever occupied its slot.
+     */
+    void insert(const GroupKey &key, const uint16_t data_A, const uint16_t data_B, const uint16_t data_C, const uint16_t data_D) {
+        CachedGroup &entry = entries[_slot(key)];
+        entry.key = key;
+        entry.data[0] = data_A;
+        entry.data[1] = data_B;
+        entry.data[2] = data_C;
+        entry.data[3] = data_D;
+        entry.used = true;
+    }
+
+    void report(std::ostream &out) const {
+        const uint64_t lookups = hits + misses;
+        const double hit_rate = lookups == 0 ? 0.0 : 100.0 * static_cast<double>(hits) / static_cast<double>(lookups);
+        out << "Group cache: " << hits << " hits, " << misses << " misses, " << hit_rate << " % hit rate, "
+            << unchanged << " groups without change" << std::endl;
+    }
+};
+
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file group_filter.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Group filter evaluated as soon as blocks A and B are validated, so groups
+ * nobody asked for skip C/D validation, character decoding and output.
+ */
+#ifndef GROUP_FILTER_HPP
+#define GROUP_FILTER_HPP
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "group_layout.hpp"
+
+#define GROUP_TYPE_COUNT (32) // 16 types x version A/B
+
+class GroupFilter {
+private:
+    std::bitset<1 << DATA_BITS> program_ids;
+    std::vector<uint16_t> program_id_list;
+    bool any_program_id = true;
+    uint32_t group_types = 0xFFFFFFFF; // Bit (type * 2 + version)
+    int traffic_program = -1;          // -1 = any
+    int traffic_announcement = -1;     // -1 = any
+
+public:
+    uint64_t rejected = 0;
+
+    /**
+     * @brief Index of the group type in the group type mask, e.g. 0A -> 0, 0B -> 1, 2A -> 4.
+     */
+    static int group_type_index(const uint16_t block_B) {
+        return ::group_type_index(block_B);
+    }
+
+    void add_program_id(const uint16_t program_id) {
+        if (any_program_id) {
+            any_program_id = false;
+            program_ids.reset();
+        }
+        program_ids.set(program_id);
+        program_id_list.push_back(program_id);
+    }
+
+    /**
+     * @brief PIs the filter is restricted to, empty if any PI is accepted.
+     */
+    const std::vector<uint16_t> &get_program_ids() const {
+        return program_id_list;
+    }
+
+    uint32_t get_group_types() const {
+        return group_types;
+    }
+
+    /**
+     * @brief Restricts the filter to the given group types (bit type * 2 + version).
+     */
+    void set_group_types(const uint32_t mask) {
+        group_types = mask;
+    }
+
+    void set_traffic_program(const int value) {
+        traffic_program = value;
+    }
+
+    void set_traffic_announcement(const int value) {
+        traffic_announcement = value;
+    }
+
+    /**
+     * @brief Decides from PI and block B whether the rest of the group is worth decoding.
+     * TA is only carried by groups 0A, 0B and 15B, other groups are not filtered on it.
+     */
+    bool accepts(const uint16_t program_id, const uint16_t block_B) {
+        const int type_index = group_type_index(block_B);
+        bool accepted = (any_program_id || program_ids.test(program_id))
+                        && ((group_types >> type_index) & 0x1)
+                        && (traffic_program < 0 || TrafficProgramField::get(block_B) == traffic_program);
+
+        const bool carries_ta = type_index == 0 || type_index == 1 || type_index == 31;
+        if (accepted && traffic_announcement >= 0 && carries_ta) {
+            accepted = Group0A::TrafficAnnouncement::get(block_B) == traffic_announcement;
+        }
+
+        if (!accepted) {
+            rejected++;
+        }
+        return accepted;
+    }
+};
+
+
+#endif
@@ -0,0 +1,293 @@
+/**
+ * @file group_layout.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Compile-time field layouts of the information words of the supported group types.
+ * The encoder packs and the decoder extracts fields through the same descriptions, and
+ * every block layout is checked at compile time to cover its 16 bits with disjoint fields.
+ */
+#ifndef GROUP_LAYOUT_HPP
+#define GROUP_LAYOUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "shared.hpp"
+
+/**
+ * @brief Field of an information word: `Width` bits starting at bit `Shift` (bit 0 = LSB).
+ */
+template<unsigned Shift, unsigned Width>
+struct BlockField {
+    static_assert(Width > 0 && Shift + Width <= DATA_BITS, "Field does not fit in an information word");
+
+    static constexpr uint16_t mask = static_cast<uint16_t>(((1u << Width) - 1) << Shift);
+
+    static constexpr uint16_t get(const uint16_t word) {
+        return static_cast<uint16_t>((word & mask) >> Shift);
+    }
+
+    /**
+     * @brief The word with the field replaced by `value` (excess bits of the value are dropped).
+     */
+    static constexpr uint16_t set(const uint16_t word, const uint32_t value) {
+        return static_cast<uint16_t>((word & ~mask) | ((value << Shift) & mask));
+    }
+};
+
+/**
+ * @brief Layout of a whole information word, fields from the most significant one.
+ */
+template<typename... Fields>
+struct BlockLayout;
+
+template<>
+struct BlockLayout<> {
+    static constexpr uint16_t mask = 0;
+    static constexpr bool disjoint = true;
+
+    static constexpr uint16_t pack() {
+        return 0;
+    }
+};
+
+template<typename Field, typename... Rest>
+struct BlockLayout<Field, Rest...> {
+    static constexpr uint16_t mask = Field::mask | BlockLayout<Rest...>::mask;
+    static constexpr bool disjoint = (Field::mask & BlockLayout<Rest...>::mask) == 0 && BlockLayout<Rest...>::disjoint;
+
+    /**
+     * @brief Information word from one value per field, in the order of the layout.
+     */
+    template<typename... Values>
+    static constexpr uint16_t pack(const uint32_t value, const Values... rest) {
+        return Field::set(BlockLayout<Rest...>::pack(rest...), value);
+    }
+};
+
+#define BLOCK_LAYOUT_CHECK(layout) \
+        static_assert(layout::disjoint && layout::mask == 0xFFFF, #layout " must cover the information word with disjoint fields")
+
+/**
+ * @brief Bit position of the checkword of a block within a group (data follows at + CRC_BITS),
+ * block A is transmitted first and sits at the top.
+ */
+constexpr std::size_t block_position(const int offset) {
+    return static_cast<std::size_t>(BLOCK_PARTS_COUNT - 1 - offset) * BLOCK_ROW_SIZE;
+}
+
+//////////////////////////
+/// Block B, common to all groups
+//////////////////////////
+using GroupTypeField = BlockField<12, 4>;
+using VersionField = BlockField<11, 1>;
+using TrafficProgramField = BlockField<10, 1>;
+using ProgramTypeField = BlockField<5, 5>;
+
+/**
+ * @brief Index of the group type, type * 2 + version (0A -> 0, 0B -> 1, 2A -> 4).
+ */
+constexpr int group_type_index(const uint16_t block_B) {
+    return GroupTypeField::get(block_B) * 2 + VersionField::get(block_B);
+}
+
+/**
+ * @brief Two characters of text, the first one in the high byte.
+ */
+using TextHighField = BlockField<8, 8>;
+using TextLowField = BlockField<0, 8>;
+using TextBlock = BlockLayout<TextHighField, TextLowField>;
+BLOCK_LAYOUT_CHECK(TextBlock);
+
+//////////////////////////
+/// 0A - Basic tuning and switching information
+//////////////////////////
+struct Group0A {
+    static constexpr uint8_t type = 0;
+    static constexpr uint8_t version = 0;
+    static constexpr int segments = BLOCKS_COUNT_IN_0A;
+    static constexpr int chars_per_segment = 2;
+
+    using TrafficAnnouncement = BlockField<4, 1>;
+    using MusicSpeech = BlockField<3, 1>;
+    using DecoderIdentification = BlockField<2, 1>;
+    using Segment = BlockField<0, 2>;
+    using BlockB = BlockLayout<GroupTypeField, VersionField, TrafficProgramField, ProgramTypeField,
+            TrafficAnnouncement, MusicSpeech, DecoderIdentification, Segment>;
+
+    using AlternativeFrequency1 = BlockField<8, 8>;
+    using AlternativeFrequency2 = BlockField<0, 8>;
+    using BlockC = BlockLayout<AlternativeFrequency1, AlternativeFrequency2>;
+
+    using BlockD = TextBlock; // Program Service characters
+};
+BLOCK_LAYOUT_CHECK(Group0A::BlockB);
+BLOCK_LAYOUT_CHECK(Group0A::BlockC);
+static_assert(Group0A::Segment::mask + 1 == Group0A::segments, "0A segment address does not match the segment count");
+
+//////////////////////////
+/// 2A - Radio Text
+//////////////////////////
+struct Group2A {
+    static constexpr uint8_t type = 2;
+    static constexpr uint8_t version = 0;
+    static constexpr int segments = BLOCKS_COUNT_IN_2A;
+    static constexpr int chars_per_segment = 4;
+    static constexpr char end_of_text = 0x0D; // Ends a text shorter than 64 characters, later segments are not sent
+
+    using TextAB = BlockField<4, 1>;
+    using Segment = BlockField<0, 4>;
+    using BlockB = BlockLayout<GroupTypeField, VersionField, TrafficProgramField, ProgramTypeField, TextAB, Segment>;
+
+    using BlockC = TextBlock;
+    using BlockD = TextBlock;
+};
+BLOCK_LAYOUT_CHECK(Group2A::BlockB);
+static_assert(Group2A::Segment::mask + 1 == Group2A::segments, "2A segment address does not match the segment count");
+
+//////////////////////////
+/// 3A - Open Data Applications (ODA) identification
+//////////////////////////
+struct Group3A {
+    static constexpr uint8_t type = 3;
+    static constexpr uint8_t version = 0;
+
+    using ApplicationGroup = BlockField<0, 5>; // Group type index (type * 2 + version) carrying the ODA
+    using BlockB = BlockLayout<GroupTypeField, VersionField, TrafficProgramField, ProgramTypeField, ApplicationGroup>;
+
+    using Message = BlockField<0, 16>; // Defined by the application
+    using BlockC = BlockLayout<Message>;
+
+    using ApplicationId = BlockField<0, 16>; // AID
+    using BlockD = BlockLayout<ApplicationId>;
+};
+BLOCK_LAYOUT_CHECK(Group3A::BlockB);
+BLOCK_LAYOUT_CHECK(Group3A::BlockC);
+BLOCK_LAYOUT_CHECK(Group3A::BlockD);
+
+//////////////////////////
+/// RadioText Plus (RT+) - ODA carried in the group announced by 3A
+//////////////////////////
+struct GroupRtPlus {
+    // 3A block C of the RT+ registration
+    using Reserved = BlockField<13, 3>;
+    using ContentBits = BlockField<12, 1>;     // CB: template carries additional data
+    using ServerControlBits = BlockField<8, 4>; // SCB
+    using TemplateNumber = BlockField<0, 8>;
+    using RegistrationBlockC = BlockLayout<Reserved, ContentBits, ServerControlBits, TemplateNumber>;
+
+    // Two tags (content type, start, length) spread over blocks B, C and D
+    using ItemToggle = BlockField<4, 1>;
+    using ItemRunning = BlockField<3, 1>;
+    using Type1High = BlockField<0, 3>;
+    using BlockB = BlockLayout<GroupTypeField, VersionField, TrafficProgramField, ProgramTypeField,
+            ItemToggle, ItemRunning, Type1High>;
+
+    using Type1Low = BlockField<13, 3>;
+    using Start1 = BlockField<7, 6>;
+    using Length1 = BlockField<1, 6>;
+    using Type2High = BlockField<0, 1>;
+    using BlockC = BlockLayout<Type1Low, Start1, Length1, Type2High>;
+
+    using Type2Low = BlockField<11, 5>;
+    using Start2 = BlockField<5, 6>;
+    using Length2 = BlockField<0, 5>;
+    using BlockD = BlockLayout<Type2Low, Start2, Length2>;
+};
+BLOCK_LAYOUT_CHECK(GroupRtPlus::RegistrationBlockC);
+BLOCK_LAYOUT_CHECK(GroupRtPlus::BlockB);
+BLOCK_LAYOUT_CHECK(GroupRtPlus::BlockC);
+BLOCK_LAYOUT_CHECK(GroupRtPlus::BlockD);
+
+//////////////////////////
+/// 8A - Traffic Message Channel (ALERT-C)
+//////////////////////////
+struct Group8A {
+    static constexpr uint8_t type = 8;
+    static constexpr uint8_t version = 0;
+
+    using Tuning = BlockField<4, 1>;              // T: tuning / system information
+    using SingleGroup = BlockField<3, 1>;         // F: single group message
+    using DurationPersistence = BlockField<0, 3>; // Single group messages
+    using ContinuityIndex = BlockField<0, 3>;     // Multi-group messages
+    using BlockB = BlockLayout<GroupTypeField, VersionField, TrafficProgramField, ProgramTypeField,
+            Tuning, SingleGroup, DurationPersistence>;
+
+    // Block C of single groups and of the first group of a multi-group message
+    using Diversion = BlockField<15, 1>;  // Single group
+    using FirstGroup = BlockField<15, 1>; // Multi-group
+    using Direction = BlockField<14, 1>;
+    using Extent = BlockField<11, 3>;
+    using Event = BlockField<0, 11>;
+    using BlockC = BlockLayout<Diversion, Direction, Extent, Event>;
+
+    // Block C of the subsequent groups of a multi-group message, free format continues in block D
+    using SecondGroup = BlockField<14, 1>;
+    using SequenceIndex = BlockField<12, 2>; // Groups still to follow
+    using FreeFormat = BlockField<0, 12>;
+    using SubsequentBlockC = BlockLayout<FirstGroup, SecondGroup, SequenceIndex, FreeFormat>;
+
+    using Location = BlockField<0, 16>;
+    using BlockD = BlockLayout<Location>;
+};
+BLOCK_LAYOUT_CHECK(Group8A::BlockB);
+BLOCK_LAYOUT_CHECK(Group8A::BlockC);
+BLOCK_LAYOUT_CHECK(Group8A::SubsequentBlockC);
+BLOCK_LAYOUT_CHECK(Group8A::BlockD);
+
+//////////////////////////
+/// 14A / 14B - Enhanced Other Networks (EON)
+//////////////////////////
+using OtherProgramIdField = BlockField<0, 16>;
+
+struct Group14A {
+    static constexpr uint8_t type = 14;
+    static constexpr uint8_t version = 0;
+    static constexpr int ps_segments = 4; // Variants 0 - 3
+    static constexpr int chars_per_segment = 2;
+
+    // Block C content by variant
+    static constexpr uint8_t variant_af = 4;            // AF of the other network (method A)
+    static constexpr uint8_t variant_mapped_first = 5;  // Tuned frequency -> mapped frequency (5 - 8 FM, 9 AM)
+    static constexpr uint8_t variant_mapped_last = 9;
+    static constexpr uint8_t variant_linkage = 12;
+    static constexpr uint8_t variant_pty_ta = 13;
+    static constexpr uint8_t variant_pin = 14;
+
+    using OtherTrafficProgram = BlockField<4, 1>;
+    using Variant = BlockField<0, 4>;
+    using BlockB = BlockLayout<GroupTypeField, VersionField, TrafficProgramField, ProgramTypeField, OtherTrafficProgram, Variant>;
+
+    using TunedFrequency = BlockField<8, 8>;
+    using MappedFrequency = BlockField<0, 8>;
+    using MappedBlockC = BlockLayout<TunedFrequency, MappedFrequency>;
+
+    using OtherProgramType = BlockField<11, 5>;
+    using Reserved = BlockField<1, 10>;
+    using OtherTrafficAnnouncement = BlockField<0, 1>;
+    using PtyTaBlockC = BlockLayout<OtherProgramType, Reserved, OtherTrafficAnnouncement>;
+
+    using BlockD = BlockLayout<OtherProgramIdField>;
+};
+BLOCK_LAYOUT_CHECK(Group14A::BlockB);
+BLOCK_LAYOUT_CHECK(Group14A::MappedBlockC);
+BLOCK_LAYOUT_CHECK(Group14A::PtyTaBlockC);
+BLOCK_LAYOUT_CHECK(Group14A::BlockD);
+
+struct Group14B {
+    static constexpr uint8_t type = 14;
+    static constexpr uint8_t version = 1;
+
+    using OtherTrafficProgram = BlockField<4, 1>;
+    using OtherTrafficAnnouncement = BlockField<3, 1>;
+    using Unused = BlockField<0, 3>;
+    using BlockB = BlockLayout<GroupTypeField, VersionField, TrafficProgramField, ProgramTypeField,
+            OtherTrafficProgram, OtherTrafficAnnouncement, Unused>;
+
+    using BlockD = BlockLayout<OtherProgramIdField>; // Block C' repeats the PI of the tuned network
+};
+BLOCK_LAYOUT_CHECK(Group14B::BlockB);
+
+
+#endif
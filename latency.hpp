@@ -0,0 +1,158 @@
+/**
+ * @file latency.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Log-bucketed (HDR-style) latency histograms. Every power of two is split
+ * into 2^LATENCY_SUB_BUCKET_BITS linear sub-buckets, which keeps the relative
+ * error of reported percentiles around 3 % with a fixed, allocation-free table.
+ */
+#ifndef LATENCY_HPP
+#define LATENCY_HPP
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+#define LATENCY_SUB_BUCKET_BITS (5)
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_BUCKETS ((64 - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+/**
+ * @brief Stages of the decoder pipeline, END_TO_END spans ingest of a group to emission of its record.
+ */
+enum class LatencyStage : uint8_t {
+    SYNC = 0,
+    CORRECTION,
+    DECODE,
+    OUTPUT,
+    END_TO_END,
+    COUNT
+};
+
+/**
+ * @brief Monotonic timestamp in nanoseconds.
+ */
+uint64_t latency_now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class LatencyHistogram {
+private:
+    uint64_t counts[LATENCY_BUCKETS] = {0};
+    uint64_t total = 0;
+    uint64_t max = 0;
+
+    static int _bucket_index(const uint64_t value) {
+        if (value < LATENCY_SUB_BUCKETS) {
+            return static_cast<int>(value);
+        }
+        const int magnitude = 63 - __builtin_clzll(value);
+        const int shift = magnitude - LATENCY_SUB_BUCKET_BITS;
+        return shift * LATENCY_SUB_BUCKETS + static_cast<int>(value >> shift);
+    }
+
+    /**
+     * @brief Highest value that falls into the bucket (HDR "highest equivalent value").
+     */
+    static uint64_t _bucket_upper(const int index) {
+        if (index < LATENCY_SUB_BUCKETS) {
+            return static_cast<uint64_t>(index);
+        }
+        const int shift = index / LATENCY_SUB_BUCKETS - 1;
+        const uint64_t sub_bucket = static_cast<uint64_t>(index % LATENCY_SUB_BUCKETS + LATENCY_SUB_BUCKETS);
+        return ((sub_bucket + 1) << shift) - 1;
+    }
+
+public:
+    void record(const uint64_t value) {
+        counts[_bucket_index(value)]++;
+        total++;
+        if (value > max) {
+            max = value;
+        }
+    }
+
+    uint64_t count() const {
+        return total;
+    }
+
+    uint64_t maximum() const {
+        return max;
+    }
+
+    /**
+     * @brief Value at the given percentile (0-100), 0 if nothing was recorded.
+     */
+    uint64_t percentile(const double percent) const {
+        if (total == 0) {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(percent / 100.0 * static_cast<double>(total) + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        }
+        uint64_t seen = 0;
+        for (int i = 0; i < LATENCY_BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                const uint64_t upper = _bucket_upper(i);
+                return upper < max ? upper : max;
+            }
+        }
+        return max;
+    }
+};
+
+/**
+ * @brief One histogram per pipeline stage plus a report in microseconds.
+ */
+class LatencyRecorder {
+private:
+    LatencyHistogram histograms[static_cast<int>(LatencyStage::COUNT)];
+
+    static const char *_stage_name(const int stage) {
+        static const char *names[] = {"sync", "correction", "decode", "output", "end-to-end"};
+        return names[stage];
+    }
+
+public:
+    bool enabled = false;
+
+    void record(const LatencyStage stage, const uint64_t start, const uint64_t end) {
+        histograms[static_cast<int>(stage)].record(end - start);
+    }
+
+    void report(std::ostream &out) const {
+        out << "Latency [us]      count        p50        p99       p999        max" << std::endl;
+        for (int stage = 0; stage < static_cast<int>(LatencyStage::COUNT); ++stage) {
+            const auto &histogram = histograms[stage];
+            out << std::left << std::setw(12) << _stage_name(stage) << std::right
+                << std::setw(11) << histogram.count()
+                << std::fixed << std::setprecision(3)
+                << std::setw(11) << histogram.percentile(50.0) / 1000.0
+                << std::setw(11) << histogram.percentile(99.0) / 1000.0
+                << std::setw(11) << histogram.percentile(99.9) / 1000.0
+                << std::setw(11) << histogram.maximum() / 1000.0 << std::endl;
+        }
+    }
+};
+
+/**
+ * @brief Set from the SIGUSR2 handler, polled by the decode loop to print a report on demand.
+ */
+static volatile std::sig_atomic_t latency_report_requested = 0;
+
+extern "C" void latency_signal_handler(int) {
+    latency_report_requested = 1;
+}
+
+void latency_install_report_signal() {
+    std::signal(SIGUSR2, latency_signal_handler);
+}
+
+
+#endif
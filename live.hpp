@@ -0,0 +1,241 @@
+/**
+ * @file live.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Live mode of the encoder: content updates arrive as lines on a FIFO or a Unix socket while groups
+ * go out continuously.
+ *
+ * The group generator reads the current carousel through an RCU-style pointer: an update builds a
+ * complete new carousel aside and swaps the pointer atomically, the generator picks it up with its
+ * next group. The old carousel is freed by the updater once the generator has passed a quiescent
+ * state (finished a group), so the generator never waits for an update.
+ */
+#ifndef LIVE_HPP
+#define LIVE_HPP
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "shared.hpp"
+
+#define LIVE_POLL_MS (100)         // How often a waiting reader checks for the stop request
+#define LIVE_GRACE_POLL_US (50)    // How often a writer checks whether the readers passed a quiescent state
+#define LIVE_READ_CHUNK (512)
+#define LIVE_LINE_MAX (4096)       // Longer lines are dropped
+
+/**
+ * @brief Set from the SIGINT/SIGTERM handler, ends the live mode.
+ */
+static volatile std::sig_atomic_t live_stop_requested = 0;
+
+extern "C" void live_signal_handler(int) {
+    live_stop_requested = 1;
+}
+
+void live_install_stop_signal() {
+    std::signal(SIGINT, live_signal_handler);
+    std::signal(SIGTERM, live_signal_handler);
+}
+
+/**
+ * @brief Block words (26 bits: information word and checkword) of the groups the generator cycles through.
+ */
+struct LiveCarousel {
+    std::vector<uint32_t> words; // BLOCK_PARTS_COUNT per group
+
+    std::size_t groups() const {
+        return words.size() / BLOCK_PARTS_COUNT;
+    }
+
+    const uint32_t *group(const std::size_t index) const {
+        return words.data() + index * BLOCK_PARTS_COUNT;
+    }
+};
+
+/**
+ * @brief Pointer with RCU-style updates: one reader, one writer.
+ * The reader never blocks, the writer waits out the grace period before freeing the old value.
+ */
+template<typename T>
+class RcuPointer {
+private:
+    std::atomic<const T *> current;
+    std::atomic<uint64_t> quiescent{0};
+
+public:
+    explicit RcuPointer(const T *initial) : current(initial) {
+    }
+
+    ~RcuPointer() {
+        delete current.load();
+    }
+
+    /**
+     * @brief Reader: the value stays valid until the reader's next quiescent_state().
+     */
+    const T *read() const {
+        return current.load();
+    }
+
+    /**
+     * @brief Reader: no longer uses the value it read.
+     */
+    void quiescent_state() {
+        quiescent.fetch_add(1);
+    }
+
+    /**
+     * @brief Writer: publishes the value (owned from now on) and frees the previous one once the reader
+     * can no longer hold it.
+     *
+     * @param stop Gives up waiting (and leaks the old value) when set, e.g. if the reader has stopped
+     */
+    void publish(const T *next, const volatile std::sig_atomic_t &stop) {
+        const T *old = current.exchange(next);
+        const uint64_t seen = quiescent.load();
+        while (quiescent.load() == seen) {
+            if (stop) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(LIVE_GRACE_POLL_US));
+        }
+        delete old;
+    }
+};
+
+/**
+ * @brief Source of update lines: a FIFO (reopened when its writer goes away) or a Unix stream socket
+ * created at the path (one client at a time).
+ */
+class LiveChannel {
+private:
+    std::string path;
+    bool is_fifo = false;
+    int listener = -1;
+    int fd = -1;
+    std::string buffer;
+
+    void _open() {
+        if (is_fifo) {
+            // Opened for writing too, so a missing writer is not an endless EOF
+            fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+        } else {
+            fd = accept(listener, nullptr, nullptr);
+        }
+    }
+
+    void _close() {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        buffer.clear();
+    }
+
+public:
+    /**
+     * @throws std::invalid_argument if the FIFO cannot be opened or the socket cannot be created
+     */
+    explicit LiveChannel(const char *path) : path(path) {
+        struct stat info{};
+        is_fifo = stat(path, &info) == 0 && S_ISFIFO(info.st_mode);
+        if (is_fifo) {
+            _open();
+            if (fd < 0) {
+                throw std::invalid_argument("Cannot open FIFO: " + this->path + ": " + std::strerror(errno));
+            }
+            return;
+        }
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (this->path.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("Socket path is too long: " + this->path);
+        }
+        std::strcpy(address.sun_path, path);
+        if (S_ISSOCK(info.st_mode)) {
+            unlink(path); // Left over from a previous run
+        }
+        listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listener, 1) != 0) {
+            const std::string error = std::strerror(errno);
+            if (listener >= 0) {
+                close(listener);
+            }
+            throw std::invalid_argument("Cannot listen on socket: " + this->path + ": " + error);
+        }
+    }
+
+    ~LiveChannel() {
+        _close();
+        if (listener >= 0) {
+            close(listener);
+            unlink(path.c_str());
+        }
+    }
+
+    LiveChannel(const LiveChannel &) = delete;
+
+    LiveChannel &operator=(const LiveChannel &) = delete;
+
+    /**
+     * @brief Waits for the next line (without the line break).
+     *
+     * @return false once stop is set
+     */
+    bool read_line(std::string &line, const volatile std::sig_atomic_t &stop) {
+        while (!stop) {
+            const std::size_t end = buffer.find('\n');
+            if (end != std::string::npos) {
+                line.assign(buffer, 0, end > 0 && buffer[end - 1] == '\r' ? end - 1 : end);
+                buffer.erase(0, end + 1);
+                return true;
+            }
+
+            if (fd < 0 && is_fifo) {
+                _open();
+            }
+
+            // Sleep in poll so the stop request is seen even without traffic
+            pollfd waiting{fd >= 0 ? fd : listener, POLLIN, 0};
+            if (poll(&waiting, 1, LIVE_POLL_MS) <= 0) {
+                continue;
+            }
+            if (fd < 0) {
+                _open(); // A client is waiting on the socket
+                continue;
+            }
+
+            char chunk[LIVE_READ_CHUNK];
+            const ssize_t count = read(fd, chunk, sizeof(chunk));
+            if (count <= 0) {
+                // Client disconnected, wait for the next one
+                _close();
+                continue;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(count));
+            if (buffer.size() > LIVE_LINE_MAX && buffer.find('\n') == std::string::npos) {
+                buffer.clear();
+            }
+        }
+        return false;
+    }
+};
+
+
+#endif
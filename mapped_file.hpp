@@ -0,0 +1,137 @@
+/**
+ * @file mapped_file.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ */
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAPPED_FILE_CHUNK (2 << 20) // Read-ahead window, size of a huge page
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+private:
+    int fd = -1;
+    uint8_t *data = nullptr;
+    std::size_t size = 0;
+    std::size_t window_chunk = SIZE_MAX; // Chunk the sequential reader is in
+
+    void _advise_chunk(const std::size_t chunk, const int advice) const {
+        const std::size_t start = chunk * MAPPED_FILE_CHUNK;
+        if (start < size) {
+            const std::size_t length = size - start < MAPPED_FILE_CHUNK ? size - start : MAPPED_FILE_CHUNK;
+            madvise(data + start, length, advice);
+        }
+    }
+
+public:
+    explicit MappedFile(const std::string &path) {
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::invalid_argument("Cannot open file: " + path + " (" + std::strerror(errno) + ")");
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::invalid_argument("Cannot stat file: " + path + " (" + std::strerror(errno) + ")");
+        }
+        size = static_cast<std::size_t>(info.st_size);
+
+        // NOTE: mmap of an empty file fails, an empty mapping is represented by nullptr
+        if (size > 0) {
+            void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw std::invalid_argument("Cannot map file: " + path + " (" + std::strerror(errno) + ")");
+            }
+            data = static_cast<uint8_t *>(mapping);
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            munmap(data, size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    const uint8_t *bytes() const {
+        return data;
+    }
+
+    std::size_t length() const {
+        return size;
+    }
+
+    /**
+     * @brief Hints the kernel that only scattered parts of the file will be touched (index lookups).
+     */
+    void advise_random() const {
+        if (data != nullptr) {
+            madvise(data, size, MADV_RANDOM);
+        }
+    }
+
+    /**
+     * @brief Hints the kernel that the file will be read once from start to end (aggressive read-ahead).
+     */
+    void advise_sequential() const {
+        if (data != nullptr) {
+            madvise(data, size, MADV_SEQUENTIAL);
+        }
+    }
+
+    /**
+     * @brief Asks for transparent huge pages where the kernel supports them for file mappings.
+     * Only a hint, failures are ignored.
+     */
+    void advise_hugepage() const {
+#ifdef MADV_HUGEPAGE
+        if (data != nullptr) {
+            madvise(data, size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    /**
+     * @brief Called by a sequential reader with its current offset. On entering a new chunk the next
+     * chunk is requested ahead (WILLNEED) and the chunk before the previous one is dropped from the
+     * mapping (DONTNEED, pages stay in the page cache), so the resident set stays a few chunks.
+     */
+    void advance(const std::size_t offset) {
+        const std::size_t chunk = offset / MAPPED_FILE_CHUNK;
+        if (data == nullptr || chunk == window_chunk) {
+            return;
+        }
+        if (window_chunk == SIZE_MAX) {
+            _advise_chunk(chunk, MADV_WILLNEED);
+        }
+        window_chunk = chunk;
+        _advise_chunk(chunk + 1, MADV_WILLNEED);
+        if (chunk >= 2) {
+            _advise_chunk(chunk - 2, MADV_DONTNEED);
+        }
+    }
+};
+
+
+#endif
@@ -0,0 +1,234 @@
+/**
+ * @file mpx.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * RDS subcarrier synthesis: differentially encoded bits are sent as shaped biphase
+ * symbols on a 57 kHz double-sideband suppressed-carrier subcarrier.
+ *
+ * Every bit adds a precomputed biphase symbol waveform (+ for differential bit 1,
+ * - for 0) to the baseband, the waveform tables are polyphase so sample rates that
+ * are not a multiple of the bit rate place every symbol at its exact fractional
+ * position. The baseband is then multiplied by one period of the carrier, also
+ * precomputed. Both inner loops are plain multiply-adds over contiguous floats.
+ */
+#ifndef MPX_HPP
+#define MPX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#define MPX_CARRIER (57000)            // Hz, 3rd harmonic of the 19 kHz pilot
+#define MPX_SAMPLE_RATE_DEFAULT (228000)
+#define MPX_SAMPLE_RATE_MIN (128000)   // Above twice the top of the RDS band (57 kHz + 2.4 kHz)
+#define MPX_SAMPLE_RATE_MAX (2000000)
+#define MPX_PHASES (64)                // Fractional symbol positions in the waveform table
+#define MPX_PRE_BITS (2.0)             // Waveform span before the bit start, in bit periods
+#define MPX_SPAN_BITS (4.5)            // Whole waveform span, in bit periods
+#define MPX_CHUNK (16384)              // Samples mixed and written at once
+
+typedef float mpx_v4f __attribute__((vector_size(16)));
+
+/**
+ * @brief dst[i] += gain * src[i]
+ */
+void mpx_accumulate(float *dst, const float *src, const std::size_t count, const float gain) {
+    std::size_t i = 0;
+    const mpx_v4f gains = {gain, gain, gain, gain};
+    for (; i + 4 <= count; i += 4) {
+        mpx_v4f a, b;
+        std::memcpy(&a, dst + i, sizeof(a));
+        std::memcpy(&b, src + i, sizeof(b));
+        a += gains * b;
+        std::memcpy(dst + i, &a, sizeof(a));
+    }
+    for (; i < count; ++i) {
+        dst[i] += gain * src[i];
+    }
+}
+
+/**
+ * @brief dst[i] = a[i] * b[i]
+ */
+void mpx_multiply(float *dst, const float *a, const float *b, const std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        mpx_v4f x, y;
+        std::memcpy(&x, a + i, sizeof(x));
+        std::memcpy(&y, b + i, sizeof(y));
+        x *= y;
+        std::memcpy(dst + i, &x, sizeof(x));
+    }
+    for (; i < count; ++i) {
+        dst[i] = a[i] * b[i];
+    }
+}
+
+/**
+ * @brief Sum of a[i] * b[i]
+ */
+float mpx_dot(const float *a, const float *b, const std::size_t count) {
+    std::size_t i = 0;
+    mpx_v4f sums = {0, 0, 0, 0};
+    for (; i + 4 <= count; i += 4) {
+        mpx_v4f x, y;
+        std::memcpy(&x, a + i, sizeof(x));
+        std::memcpy(&y, b + i, sizeof(y));
+        sums += x * y;
+    }
+    float sum = sums[0] + sums[1] + sums[2] + sums[3];
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Impulse response of the RDS data shaping filter H(f) = cos(pi * f * td / 4), 0 <= f <= 2 / td.
+ *
+ * @param t Time in seconds
+ */
+double mpx_shaping_pulse(const double t) {
+    const double td = 1.0 / BIT_RATE;
+    const double a = M_PI * td / 4;
+    const double b = 2 * M_PI * t;
+    const double f_max = 2.0 / td;
+    // 2 * integral_0^f_max cos(a f) cos(b f) df
+    const double diff = std::fabs(a - b) < 1e-12 ? f_max : std::sin((a - b) * f_max) / (a - b);
+    const double sum = std::sin((a + b) * f_max) / (a + b);
+    return diff + sum;
+}
+
+class MpxSynthesizer {
+private:
+    uint32_t sample_rate;
+    double samples_per_bit;
+    std::size_t length;         // Samples of one waveform
+    std::vector<float> shapes;  // MPX_PHASES x length
+    std::vector<float> carrier; // One period of the carrier
+    std::size_t carrier_position = 0;
+
+    std::vector<float> baseband; // Samples from `base` on, still being summed
+    uint64_t base = 0;
+    uint64_t bit_index = 0;
+    uint8_t state = 0; // Last differential bit
+    std::vector<float> mixed;
+
+    static uint32_t _gcd(uint32_t a, uint32_t b) {
+        while (b != 0) {
+            const uint32_t r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    void _build_shapes() {
+        const double td = 1.0 / BIT_RATE;
+        length = static_cast<std::size_t>(std::ceil(MPX_SPAN_BITS * samples_per_bit)) + 1;
+        shapes.assign(MPX_PHASES * length, 0.0f);
+        for (int phase = 0; phase < MPX_PHASES; ++phase) {
+            const double fraction = static_cast<double>(phase) / MPX_PHASES;
+            for (std::size_t m = 0; m < length; ++m) {
+                const double t = (static_cast<double>(m) - fraction) / sample_rate - MPX_PRE_BITS * td;
+                // Biphase symbol: opposite impulses half a bit apart through the shaping filter
+                shapes[phase * length + m] = static_cast<float>(mpx_shaping_pulse(t) - mpx_shaping_pulse(t - td / 2));
+            }
+        }
+
+        // Normalize to the worst case sum of overlapping symbols so the output stays within [-1, 1]
+        double peak = 0;
+        const auto step = static_cast<std::size_t>(samples_per_bit);
+        for (std::size_t m = 0; m < step; ++m) {
+            double sum = 0;
+            for (std::size_t k = m; k < length; k += step) {
+                sum += std::fabs(shapes[k]);
+            }
+            peak = sum > peak ? sum : peak;
+        }
+        for (auto &value: shapes) {
+            value = static_cast<float>(value / peak);
+        }
+    }
+
+    void _build_carrier() {
+        const uint32_t period = sample_rate / _gcd(sample_rate, MPX_CARRIER);
+        carrier.resize(period);
+        for (uint32_t n = 0; n < period; ++n) {
+            carrier[n] = static_cast<float>(std::cos(2 * M_PI * MPX_CARRIER * static_cast<double>(n) / sample_rate));
+        }
+    }
+
+    /**
+     * @brief Mixes the first `count` baseband samples to the carrier and writes them.
+     */
+    template<typename Writer>
+    void _emit(const std::size_t count, Writer &writer) {
+        mixed.resize(count);
+        std::size_t done = 0;
+        while (done < count) {
+            const std::size_t span = std::min(count - done, carrier.size() - carrier_position);
+            mpx_multiply(mixed.data() + done, baseband.data() + done, carrier.data() + carrier_position, span);
+            done += span;
+            carrier_position = (carrier_position + span) % carrier.size();
+        }
+        writer.write(mixed.data(), count);
+
+        baseband.erase(baseband.begin(), baseband.begin() + static_cast<std::ptrdiff_t>(count));
+        base += count;
+    }
+
+public:
+    /**
+     * @throws std::invalid_argument if the sample rate is out of range
+     */
+    explicit MpxSynthesizer(const uint32_t sample_rate) : sample_rate(sample_rate), samples_per_bit(sample_rate / BIT_RATE) {
+        if (sample_rate < MPX_SAMPLE_RATE_MIN || sample_rate > MPX_SAMPLE_RATE_MAX) {
+            throw std::invalid_argument("Sample rate must be between " + std::to_string(MPX_SAMPLE_RATE_MIN) + " and " + std::to_string(MPX_SAMPLE_RATE_MAX) + " Hz");
+        }
+        _build_shapes();
+        _build_carrier();
+        baseband.reserve(MPX_CHUNK + 2 * length);
+    }
+
+    /**
+     * @brief Adds one data bit, writes samples that no later bit can change anymore.
+     */
+    template<typename Writer>
+    void push_bit(const int bit, Writer &writer) {
+        state = static_cast<uint8_t>(state ^ (bit & 0x1));
+
+        const double start = static_cast<double>(bit_index++) * samples_per_bit;
+        const auto first = static_cast<uint64_t>(start);
+        const auto phase = static_cast<int>((start - static_cast<double>(first)) * MPX_PHASES + 0.5);
+        // Rounding the phase up to a whole sample moves the waveform one sample later
+        const uint64_t offset = first + (phase == MPX_PHASES ? 1 : 0) - base;
+        const float *shape = shapes.data() + (phase % MPX_PHASES) * length;
+
+        if (baseband.size() < offset + length) {
+            baseband.resize(offset + length, 0.0f);
+        }
+        mpx_accumulate(baseband.data() + offset, shape, length, state ? 1.0f : -1.0f);
+
+        // Samples before the start of the next bit are final
+        const auto next = static_cast<uint64_t>(static_cast<double>(bit_index) * samples_per_bit) - base;
+        if (next >= MPX_CHUNK) {
+            _emit(static_cast<std::size_t>(next), writer);
+        }
+    }
+
+    /**
+     * @brief Writes the rest of the signal including the tail of the last symbol.
+     */
+    template<typename Writer>
+    void finish(Writer &writer) {
+        _emit(baseband.size(), writer);
+    }
+};
+
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file rds_compress.cpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Compresses archived ASCII bitstreams (as printed by rds_encoder) to the .rdsz format and back.
+ */
+#include "rds_compress.hpp"
+
+class Args {
+private:
+    std::map<std::string, char *> cached_args;
+    char **argv;
+    int argc;
+
+    /**
+     * @brief Returns the argument value corresponding to the given short or long option.
+     * Caches the result so subsequent lookups are faster.
+     */
+    char *_get_arg(const std::string &short_option, const std::string &long_option) {
+        // Check if the argument is already cached
+        std::string key = short_option.empty() ? long_option : short_option;
+        if (cached_args.find(key) != cached_args.end()) {
+            return cached_args[key]; // Return cached value
+        }
+
+        // If no cached value, search for it in argv
+        for (int i = 0; i < argc; i++) {
+            if (!short_option.empty() && strcmp(argv[i], short_option.c_str()) == 0) {
+                cached_args[short_option] = argv[i + 1]; // Cache the result
+                return argv[i + 1];
+            } else if (!long_option.empty() && strcmp(argv[i], long_option.c_str()) == 0) {
+                cached_args[long_option] = argv[i + 1]; // Cache the result
+                return argv[i + 1];
+            }
+        }
+
+        return nullptr; // If not found
+    }
+
+    /**
+     * @brief Checks if a given option is defined.
+     * Caches the result.
+     */
+    bool _is_defined(const std::string &short_option, const std::string &long_option) {
+        // Check if the result is already cached
+        std::string key = short_option.empty() ? long_option : short_option;
+        if (cached_args.find(key) != cached_args.end()) {
+            return true; // It was already defined
+        }
+
+        // Search argv for the option
+        for (int i = 0; i < argc; i++) {
+            if (!short_option.empty() && strcmp(argv[i], short_option.c_str()) == 0) {
+                cached_args[short_option] = argv[i]; // Cache it
+                return true;
+            } else if (!long_option.empty() && strcmp(argv[i], long_option.c_str()) == 0) {
+                cached_args[long_option] = argv[i]; // Cache it
+                return true;
+            }
+        }
+
+        return false; // Not defined
+    }
+
+public:
+    Args(char **argv, int argc) : argv(argv), argc(argc) {}
+
+    ~Args() = default;
+
+    bool get_help() {
+        return this->_is_defined("-h", "--help");
+    }
+
+    /**
+     * -d
+     * Decompress instead of compress.
+     */
+    bool get_decompress() {
+        return this->_is_defined("-d", "--decompress");
+    }
+
+    /**
+     * -s
+     * Print compression statistics to stderr.
+     */
+    bool get_stats() {
+        return this->_is_defined("-s", "--stats");
+    }
+
+    /**
+     * -i
+     * Input file.
+     *
+     * @throws std::invalid_argument
+     */
+    std::string get_input() {
+        const char *file = this->_get_arg("-i", "--input");
+        if (file == nullptr) {
+            throw std::invalid_argument("Input file is not specified. Option: -i, --input");
+        }
+        return file;
+    }
+
+    /**
+     * -o
+     * Output file.
+     *
+     * @throws std::invalid_argument
+     */
+    std::string get_output() {
+        const char *file = this->_get_arg("-o", "--output");
+        if (file == nullptr) {
+            throw std::invalid_argument("Output file is not specified. Option: -o, --output");
+        }
+        return file;
+    }
+
+    void print_usage() {
+        std::cout << "Usage: rds_compress [options]" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  -h, --help\t\t\tShow this help message and exit" << std::endl;
+        std::cout << "  -i, --input <file>\t\tASCII bitstream to compress (.rdsz with -d)" << std::endl;
+        std::cout << "  -o, --output <file>\t\tCompressed stream (ASCII bitstream with -d)" << std::endl;
+        std::cout << "  -d, --decompress\t\tDecompress instead of compress" << std::endl;
+        std::cout << "  -s, --stats\t\t\tPrint compression statistics to stderr" << std::endl;
+    }
+};
+
+/**
+ * @brief Class that holds global variables for the whole program
+ */
+class Program {
+private:
+    std::ofstream output;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+
+    void _open_output(const std::string &path) {
+        output.open(path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            throw std::invalid_argument("Cannot create output file: " + path);
+        }
+    }
+
+    template<typename Buffer>
+    void _flush(Buffer &buffer) {
+        output.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!output) {
+            throw std::invalid_argument("Cannot write output file.");
+        }
+        bytes_out += buffer.size();
+        buffer.clear();
+    }
+
+    void _compress(const MappedFile &input) {
+        const auto text = reinterpret_cast<const char *>(input.bytes());
+        const std::size_t size = input.length();
+        input.advise_sequential();
+
+        GroupCompressor compressor;
+        std::vector<uint8_t> buffer;
+        buffer.reserve(RDSZ_BUFFER_SIZE + RDSZ_HEADER_SIZE + RDSZ_LITERAL_SIZE + 1);
+        GroupCompressor::write_header(buffer);
+
+        std::size_t position = 0;
+        while (position < size) {
+            const char c = text[position];
+            if (c == '\n') {
+                compressor.newline(buffer);
+                position++;
+            } else if (c == '\r' || c == ' ' || c == '\t') {
+                position++;
+            } else {
+                RawGroup group;
+                if (size - position < SIZE_GROUP || !parse_ascii_group(text + position, group)) {
+                    throw std::invalid_argument("Invalid or incomplete group at offset " + std::to_string(position) + ". Expected " + std::to_string(SIZE_GROUP) + " characters '0'/'1'.");
+                }
+                compressor.group(group, buffer);
+                position += SIZE_GROUP;
+            }
+
+            if (buffer.size() >= RDSZ_BUFFER_SIZE) {
+                _flush(buffer);
+            }
+        }
+        _flush(buffer);
+
+        if (args->get_stats()) {
+            std::cerr << "Groups: " << compressor.groups << " (" << compressor.references << " references, "
+                      << compressor.deltas << " deltas, " << compressor.literals << " literals)" << std::endl;
+        }
+    }
+
+    void _decompress(const MappedFile &input) {
+        input.advise_sequential();
+        GroupDecompressor decompressor(input.bytes(), input.length());
+
+        std::string buffer;
+        buffer.reserve(RDSZ_BUFFER_SIZE + SIZE_GROUP);
+        RawGroup group;
+        uint64_t groups = 0;
+        for (auto item = decompressor.next(group); item != GroupDecompressor::Item::END; item = decompressor.next(group)) {
+            if (item == GroupDecompressor::Item::NEWLINE) {
+                buffer.push_back('\n');
+            } else {
+                format_ascii_group(group, buffer);
+                groups++;
+            }
+
+            if (buffer.size() >= RDSZ_BUFFER_SIZE) {
+                _flush(buffer);
+            }
+        }
+        _flush(buffer);
+
+        if (args->get_stats()) {
+            std::cerr << "Groups: " << groups << std::endl;
+        }
+    }
+
+public:
+    Args *args;
+
+    Program(Args *args) : args(args) {
+    }
+
+    ~Program() {
+        delete args;
+    }
+
+    void run() {
+        const MappedFile input(args->get_input());
+        _open_output(args->get_output());
+        bytes_in = input.length();
+
+        const auto start = std::chrono::steady_clock::now();
+        if (args->get_decompress()) {
+            _decompress(input);
+        } else {
+            _compress(input);
+        }
+        output.close();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (args->get_stats()) {
+            const double ratio = bytes_out == 0 ? 0.0 : static_cast<double>(bytes_in) / static_cast<double>(bytes_out);
+            const double throughput = elapsed.count() == 0 ? 0.0 : static_cast<double>(std::max(bytes_in, bytes_out)) / elapsed.count() / 1e6;
+            std::cerr << "Bytes: " << bytes_in << " -> " << bytes_out << " (ratio " << ratio << "), "
+                      << throughput << " MB/s" << std::endl;
+        }
+    }
+
+    int exit_with_code(const int code, const std::string &message = "") {
+        // Print message to stderr if code is not 0 and message is not empty
+        if (code != 0 && !message.empty()) {
+            std::cerr << message << std::endl;
+        }
+
+        // Print message to stdout if code is 0 and message is not empty
+        if (code == 0 && !message.empty()) {
+            std::cout << message << std::endl;
+        }
+
+        delete this;
+
+        // Cleanup and exit
+        exit(code);
+    }
+};
+
+int main(int argc, char *argv[]) {
+    auto *program = new Program(new Args(argv, argc));
+
+    if (program->args->get_help()) {
+        program->args->print_usage();
+        program->exit_with_code(0);
+    }
+
+    try {
+        program->run();
+    } catch (const std::invalid_argument &e) {
+        program->exit_with_code(1, e.what());
+    } catch (const std::exception &e) {
+        program->exit_with_code(1, e.what());
+    }
+
+    // Exit with success code and no message
+    program->exit_with_code(0);
+}
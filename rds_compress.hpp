@@ -0,0 +1,23 @@
+/**
+ * @file rds_compress.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ */
+#ifndef RDS_COMPRESS_HPP
+#define RDS_COMPRESS_HPP
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+#include "shared.hpp"
+#include "mapped_file.hpp"
+#include "compress.hpp"
+
+#endif
@@ -125,18 +125,473 @@ public:
             throw std::invalid_argument("Binary data is empty. Option: -b, --binary-data");
         }
 
-        if (data.size() % SIZE_2A && data.size() % SIZE_0A) {
-            throw std::invalid_argument("Invalid binary data size: " + std::to_string(data.size()) + ". Expected: " + std::to_string(SIZE_2A) + " or " + std::to_string(SIZE_0A));
+        // NOTE: Symbols are checked after biphase decoding, the stream may start in the middle of a symbol
+        // Radio Text may end early, so any whole number of groups is accepted
+        if (!this->get_biphase() && data.size() % SIZE_GROUP) {
+            throw std::invalid_argument("Invalid binary data size: " + std::to_string(data.size()) + ". Expected a multiple of " + std::to_string(SIZE_GROUP));
         }
 
         return data;
     }
 
+    /**
+     * Common
+     * -tr
+     * Trace dump file, written on SIGUSR1, on error and at exit.
+     *
+     * @return const char * or nullptr if tracing to a file is not requested
+     */
+    const char *get_trace_file() {
+        return this->_get_arg("-tr", "--trace");
+    }
+
+    /**
+     * -l
+     * Measure per-stage and end-to-end latency, report percentiles on SIGUSR2 and at exit.
+     */
+    bool get_latency() {
+        return this->_is_defined("-l", "--latency");
+    }
+
+    /**
+     * -cs
+     * Report group cache hit rate at exit.
+     */
+    bool get_cache_stats() {
+        return this->_is_defined("-cs", "--cache-stats");
+    }
+
+    /**
+     * -fpi, -fgt, -ftp, -fta
+     * Group filter: comma separated PIs (decimal or 0x hex), comma separated group types (e.g. 0A,2A),
+     * required TP and TA flags.
+     *
+     * @throws std::invalid_argument
+     */
+    void configure_filter(GroupFilter &filter) {
+        const char *program_ids = this->_get_arg("-fpi", "--filter-pi");
+        if (program_ids != nullptr) {
+            std::stringstream ss(program_ids);
+            std::string token;
+            while (std::getline(ss, token, ',')) {
+                try {
+                    const auto program_id = std::stoul(token, nullptr, 0);
+                    if (program_id > 0xFFFF) {
+                        throw std::out_of_range(token);
+                    }
+                    filter.add_program_id(static_cast<uint16_t>(program_id));
+                } catch (const std::logic_error &) {
+                    throw std::invalid_argument("Invalid PI in filter: " + token + ". Option: -fpi, --filter-pi");
+                }
+            }
+        }
+
+        const char *group_types = this->_get_arg("-fgt", "--filter-group-type");
+        if (group_types != nullptr) {
+            uint32_t mask = 0;
+            std::stringstream ss(group_types);
+            std::string token;
+            while (std::getline(ss, token, ',')) {
+                std::size_t end = 0;
+                int type = -1;
+                try {
+                    type = std::stoi(token, &end);
+                } catch (const std::logic_error &) {
+                }
+                if (type < 0 || type > 15 || end + 1 != token.size() || (token[end] != 'A' && token[end] != 'B')) {
+                    throw std::invalid_argument("Invalid group type in filter: " + token + ". Option: -fgt, --filter-group-type");
+                }
+                mask |= 1u << (type * 2 + (token[end] == 'B' ? 1 : 0));
+            }
+            filter.set_group_types(mask);
+        }
+
+        const char *traffic_program = this->_get_arg("-ftp", "--filter-tp");
+        if (traffic_program != nullptr) {
+            if (!this->_is_same(traffic_program, "0") && !this->_is_same(traffic_program, "1")) {
+                throw std::invalid_argument("TP filter must be 0 or 1. Option: -ftp, --filter-tp");
+            }
+            filter.set_traffic_program(traffic_program[0] - '0');
+        }
+
+        const char *traffic_announcement = this->_get_arg("-fta", "--filter-ta");
+        if (traffic_announcement != nullptr) {
+            if (!this->_is_same(traffic_announcement, "0") && !this->_is_same(traffic_announcement, "1")) {
+                throw std::invalid_argument("TA filter must be 0 or 1. Option: -fta, --filter-ta");
+            }
+            filter.set_traffic_announcement(traffic_announcement[0] - '0');
+        }
+    }
+
+    /**
+     * -co
+     * Capture container to write the synchronized (and filtered) groups to.
+     */
+    const char *get_capture_out() {
+        return this->_get_arg("-co", "--capture-out");
+    }
+
+    /**
+     * -ci
+     * Capture container to decode instead of -b.
+     */
+    const char *get_capture_in() {
+        return this->_get_arg("-ci", "--capture-in");
+    }
+
+    /**
+     * -f
+     * Bitstream file to decode instead of -b, read through a memory mapping.
+     */
+    const char *get_file() {
+        return this->_get_arg("-f", "--file");
+    }
+
+    /**
+     * -pk
+     * The -f file is a packed bitstream (8 bits per byte, MSB first) instead of '0'/'1' characters.
+     */
+    bool get_packed() {
+        return this->_is_defined("-pk", "--packed");
+    }
+
+    /**
+     * -bp
+     * The -b/-f input are differentially encoded biphase half-symbols (two per bit) instead of bits.
+     */
+    bool get_biphase() {
+        return this->_is_defined("-bp", "--biphase");
+    }
+
+    /**
+     * -mpx
+     * MPX sample file (WAV, or raw 32-bit floats with -raw) to demodulate and decode instead of -b.
+     */
+    const char *get_mpx_file() {
+        return this->_get_arg("-mpx", "--mpx");
+    }
+
+    /**
+     * -raw
+     * The -mpx file is headerless 32-bit floats, the sample rate is given by -sr.
+     */
+    bool get_raw() {
+        return this->_is_defined("-raw", "--raw");
+    }
+
+    /**
+     * -sr
+     * Sample rate of a raw -mpx file in Hz (-iq files: get_iq_sample_rate).
+     *
+     * @throws std::invalid_argument
+     */
+    uint32_t get_sample_rate() {
+        const char *arg_value = this->_get_arg("-sr", "--sample-rate");
+        if (arg_value == nullptr) {
+            return MPX_SAMPLE_RATE_DEFAULT;
+        }
+        try {
+            const auto sample_rate = std::stoul(arg_value);
+            if (sample_rate < MPX_SAMPLE_RATE_MIN || sample_rate > MPX_SAMPLE_RATE_MAX) {
+                throw std::out_of_range(arg_value);
+            }
+            return static_cast<uint32_t>(sample_rate);
+        } catch (const std::logic_error &) {
+            throw std::invalid_argument("Invalid sample rate: " + std::string(arg_value) + ". Expected " + std::to_string(MPX_SAMPLE_RATE_MIN) + " - " + std::to_string(MPX_SAMPLE_RATE_MAX) + " Hz. Option: -sr, --sample-rate");
+        }
+    }
+
+    /**
+     * -iq
+     * Wideband IQ recording (headerless interleaved I/Q) to decode all FM stations of.
+     */
+    const char *get_iq_file() {
+        return this->_get_arg("-iq", "--iq");
+    }
+
+    /**
+     * -iqf
+     * Sample format of the -iq file: cu8, cs16 or cf32 (default).
+     *
+     * @throws std::invalid_argument
+     */
+    IqFormat get_iq_format() {
+        const char *arg_value = this->_get_arg("-iqf", "--iq-format");
+        if (arg_value == nullptr || this->_is_same(arg_value, "cf32")) {
+            return IqFormat::CF32;
+        } else if (this->_is_same(arg_value, "cs16")) {
+            return IqFormat::CS16;
+        } else if (this->_is_same(arg_value, "cu8")) {
+            return IqFormat::CU8;
+        }
+        throw std::invalid_argument("Invalid IQ format: " + std::string(arg_value) + ". Expected cu8, cs16 or cf32. Option: -iqf, --iq-format");
+    }
+
+    /**
+     * @brief Parses a positive integer option.
+     *
+     * @throws std::invalid_argument
+     */
+    uint64_t _parse_positive(const char *value, const std::string &option) {
+        try {
+            const auto number = std::stoull(value);
+            if (number == 0) {
+                throw std::out_of_range(value);
+            }
+            return number;
+        } catch (const std::logic_error &) {
+            throw std::invalid_argument("Invalid value: " + std::string(value) + ". Option: " + option);
+        }
+    }
+
+    /**
+     * -sr
+     * Sample rate of the -iq file in Hz, required.
+     *
+     * @throws std::invalid_argument
+     */
+    uint32_t get_iq_sample_rate() {
+        const char *arg_value = this->_get_arg("-sr", "--sample-rate");
+        if (arg_value == nullptr) {
+            throw std::invalid_argument("Sample rate of the IQ file is not specified. Option: -sr, --sample-rate");
+        }
+        const auto sample_rate = this->_parse_positive(arg_value, "-sr, --sample-rate");
+        if (sample_rate > UINT32_MAX) {
+            throw std::invalid_argument("Invalid sample rate: " + std::string(arg_value) + ". Option: -sr, --sample-rate");
+        }
+        return static_cast<uint32_t>(sample_rate);
+    }
+
+    /**
+     * -fc
+     * Center frequency of the -iq file in Hz, required.
+     *
+     * @throws std::invalid_argument
+     */
+    double get_center_frequency() {
+        const char *arg_value = this->_get_arg("-fc", "--center-frequency");
+        if (arg_value == nullptr) {
+            throw std::invalid_argument("Center frequency of the IQ file is not specified. Option: -fc, --center-frequency");
+        }
+        return static_cast<double>(this->_parse_positive(arg_value, "-fc, --center-frequency"));
+    }
+
+    /**
+     * -chs
+     * FM channel grid spacing in Hz (default 100000).
+     *
+     * @throws std::invalid_argument
+     */
+    uint32_t get_channel_spacing() {
+        const char *arg_value = this->_get_arg("-chs", "--channel-spacing");
+        if (arg_value == nullptr) {
+            return CHANNELIZER_SPACING_DEFAULT;
+        }
+        const auto spacing = this->_parse_positive(arg_value, "-chs, --channel-spacing");
+        if (spacing > UINT32_MAX) {
+            throw std::invalid_argument("Invalid channel spacing: " + std::string(arg_value) + ". Option: -chs, --channel-spacing");
+        }
+        return static_cast<uint32_t>(spacing);
+    }
+
+    /**
+     * -j
+     * Worker threads for per-station decoding (default one per hardware thread).
+     *
+     * @throws std::invalid_argument
+     */
+    std::size_t get_jobs() {
+        const char *arg_value = this->_get_arg("-j", "--jobs");
+        return arg_value == nullptr ? 0 : static_cast<std::size_t>(this->_parse_positive(arg_value, "-j, --jobs"));
+    }
+
+    /**
+     * -sn
+     * Snapshot file of the station state. Restored at start (if it exists), the -f input is then decoded from
+     * the offset the snapshot was taken at. Written every -sni groups and at the end.
+     *
+     * @return const char * or nullptr if no snapshot is kept
+     */
+    const char *get_snapshot() {
+        return this->_get_arg("-sn", "--snapshot");
+    }
+
+    /**
+     * -sni
+     * Groups between two snapshots (default 10000).
+     *
+     * @throws std::invalid_argument
+     */
+    uint64_t get_snapshot_interval() {
+        const char *arg_value = this->_get_arg("-sni", "--snapshot-interval");
+        return arg_value == nullptr ? SNAPSHOT_DEFAULT_INTERVAL : this->_parse_positive(arg_value, "-sni, --snapshot-interval");
+    }
+
+    /**
+     * -stc
+     * Stations kept at once (default 256), CLOCK (approximate LRU) evicts one for a new PI.
+     * The EON link table gets EON_LINKS_PER_STATION slots per station.
+     *
+     * @throws std::invalid_argument
+     */
+    std::size_t get_station_capacity() {
+        const char *arg_value = this->_get_arg("-stc", "--station-capacity");
+        if (arg_value == nullptr) {
+            return STATION_TABLE_DEFAULT_CAPACITY;
+        }
+        const auto capacity = this->_parse_positive(arg_value, "-stc, --station-capacity");
+        if (capacity > STATION_TABLE_MAX_CAPACITY) {
+            throw std::invalid_argument("Station capacity must be at most " + std::to_string(STATION_TABLE_MAX_CAPACITY) + ". Option: -stc, --station-capacity");
+        }
+        return static_cast<std::size_t>(capacity);
+    }
+
+    /**
+     * -sb
+     * File of soft bits to decode: one int8 per bit, the sign is the bit (positive = 1), the magnitude its reliability.
+     */
+    const char *get_soft_bits() {
+        return this->_get_arg("-sb", "--soft-bits");
+    }
+
+    /**
+     * -ch
+     * Least reliable bits the Chase correction of soft input flips (default 5, 0 = off).
+     *
+     * @throws std::invalid_argument
+     */
+    int get_chase_bits() {
+        const char *arg_value = this->_get_arg("-ch", "--chase");
+        if (arg_value == nullptr) {
+            return BLOCK_CHASE_BITS_DEFAULT;
+        }
+        try {
+            const auto bits = std::stoul(arg_value);
+            if (bits > BLOCK_CHASE_BITS_MAX) {
+                throw std::out_of_range(arg_value);
+            }
+            return static_cast<int>(bits);
+        } catch (const std::logic_error &) {
+            throw std::invalid_argument("Invalid Chase bit count: " + std::string(arg_value) + ". Expected 0 - " + std::to_string(BLOCK_CHASE_BITS_MAX) + ". Option: -ch, --chase");
+        }
+    }
+
+    /**
+     * -z
+     * Compressed bitstream (rds_compress) to decode instead of -b.
+     */
+    const char *get_compressed() {
+        return this->_get_arg("-z", "--compressed");
+    }
+
+    /**
+     * -tmce
+     * Compiled TMC event table (-tmcc) the event codes of 8A groups are resolved with.
+     */
+    const char *get_tmc_events() {
+        return this->_get_arg("-tmce", "--tmc-events");
+    }
+
+    /**
+     * -tmcl
+     * Compiled TMC location table (-tmcc) the location codes of 8A groups are resolved with.
+     */
+    const char *get_tmc_locations() {
+        return this->_get_arg("-tmcl", "--tmc-locations");
+    }
+
+    /**
+     * -tmcc
+     * `code;text` CSV to compile into a TMC table (-tmco) instead of decoding.
+     */
+    const char *get_tmc_compile() {
+        return this->_get_arg("-tmcc", "--tmc-compile");
+    }
+
+    /**
+     * -tmco
+     * Output of -tmcc.
+     *
+     * @throws std::invalid_argument
+     */
+    const char *get_tmc_out() {
+        const char *arg_value = this->_get_arg("-tmco", "--tmc-out");
+        if (arg_value == nullptr) {
+            throw std::invalid_argument("TMC table output is not specified. Option: -tmco, --tmc-out");
+        }
+        return arg_value;
+    }
+
+    /**
+     * @brief Parses seconds since the Unix epoch (fractions allowed) to microseconds.
+     */
+    uint64_t _parse_time(const char *value, const std::string &option) {
+        try {
+            const double seconds = std::stod(value);
+            if (seconds < 0) {
+                throw std::out_of_range(value);
+            }
+            return static_cast<uint64_t>(seconds * 1000000.0 + 0.5);
+        } catch (const std::logic_error &) {
+            throw std::invalid_argument("Invalid time: " + std::string(value) + ". Option: " + option);
+        }
+    }
+
+    /**
+     * -from
+     * Start of the time range read from a capture (seconds since the Unix epoch).
+     */
+    uint64_t get_time_from() {
+        const char *value = this->_get_arg("-from", "--from");
+        return value == nullptr ? 0 : this->_parse_time(value, "-from, --from");
+    }
+
+    /**
+     * -to
+     * End of the time range read from a capture (seconds since the Unix epoch).
+     */
+    uint64_t get_time_to() {
+        const char *value = this->_get_arg("-to", "--to");
+        return value == nullptr ? UINT64_MAX : this->_parse_time(value, "-to, --to");
+    }
+
     void print_usage() {
         std::cout << "Usage: rds_decoder [options]" << std::endl;
         std::cout << "Options:" << std::endl;
         std::cout << "  -h, --help\t\t\tShow this help message and exit" << std::endl;
         std::cout << "  -b, --binary-data\t\tThe binary data to decode" << std::endl;
+        std::cout << "  -tr, --trace <file>\t\tTrace dump file (written on SIGUSR1, error and exit)" << std::endl;
+        std::cout << "  -l, --latency\t\t\tReport latency percentiles on SIGUSR2 and at exit" << std::endl;
+        std::cout << "  -cs, --cache-stats\t\tReport group cache hit rate at exit" << std::endl;
+        std::cout << "  -fpi, --filter-pi <list>\tDecode only the given PIs (e.g. 4660,0x1235)" << std::endl;
+        std::cout << "  -fgt, --filter-group-type <list>\tDecode only the given group types (e.g. 0A,2A)" << std::endl;
+        std::cout << "  -ftp, --filter-tp <0|1>\tDecode only groups with the given TP flag" << std::endl;
+        std::cout << "  -fta, --filter-ta <0|1>\tDecode only groups with the given TA flag (0A, 0B, 15B)" << std::endl;
+        std::cout << "  -co, --capture-out <file>\tWrite synchronized groups to a capture container" << std::endl;
+        std::cout << "  -ci, --capture-in <file>\tDecode a capture container instead of -b" << std::endl;
+        std::cout << "  -f, --file <file>\t\tDecode a bitstream file ('0'/'1', whitespace allowed) instead of -b" << std::endl;
+        std::cout << "  -pk, --packed\t\t\tThe -f file is packed, 13 bytes (104 bits) per group" << std::endl;
+        std::cout << "  -bp, --biphase\t\t\tThe -b/-f input are biphase symbols (two per bit)" << std::endl;
+        std::cout << "  -mpx, --mpx <file>\t\tDemodulate an MPX sample file (WAV) instead of -b" << std::endl;
+        std::cout << "  -raw, --raw\t\t\tThe -mpx file is raw 32-bit floats" << std::endl;
+        std::cout << "  -sr, --sample-rate <rate>\tSample rate of a raw -mpx file (default 228000) or of an -iq file in Hz" << std::endl;
+        std::cout << "  -iq, --iq <file>\t\tDecode all FM stations of a wideband IQ recording" << std::endl;
+        std::cout << "  -iqf, --iq-format <format>\tIQ sample format: cu8, cs16, cf32 (default)" << std::endl;
+        std::cout << "  -fc, --center-frequency <Hz>\tCenter frequency of the IQ recording" << std::endl;
+        std::cout << "  -chs, --channel-spacing <Hz>\tFM channel grid (default 100000), the IQ sample rate (-sr) must be a multiple" << std::endl;
+        std::cout << "  -j, --jobs <count>\t\tThreads decoding the stations of an IQ recording" << std::endl;
+        std::cout << "  -sn, --snapshot <file>\tRestore the station state and -f offset from the file, write it every -sni groups" << std::endl;
+        std::cout << "  -sni, --snapshot-interval <groups>\tGroups between two snapshots (default 10000)" << std::endl;
+        std::cout << "  -stc, --station-capacity <count>\tStations kept at once, CLOCK (approximate LRU) eviction (default 256)" << std::endl;
+        std::cout << "  -sb, --soft-bits <file>\tDecode int8 soft bits (sign = bit, magnitude = reliability) instead of -b" << std::endl;
+        std::cout << "  -ch, --chase <bits>\t\tLeast reliable bits flipped to correct a soft block (default 5, 0 = off)" << std::endl;
+        std::cout << "  -z, --compressed <file>\tDecode a compressed bitstream (rds_compress) instead of -b" << std::endl;
+        std::cout << "  -tmce, --tmc-events <file>\tCompiled TMC event table for 8A groups" << std::endl;
+        std::cout << "  -tmcl, --tmc-locations <file>\tCompiled TMC location table for 8A groups" << std::endl;
+        std::cout << "  -tmcc, --tmc-compile <csv>\tCompile a 'code;text' CSV into a TMC table (-tmco) and exit" << std::endl;
+        std::cout << "  -tmco, --tmc-out <file>\tOutput of -tmcc" << std::endl;
+        std::cout << "  -from, --from <seconds>\tStart of the time range read from a capture" << std::endl;
+        std::cout << "  -to, --to <seconds>\t\tEnd of the time range read from a capture" << std::endl;
     }
 };
 
@@ -177,147 +632,1167 @@ public:
 
     ~Block() = default;
 
-    Block &operator=(const Block &other) = default;
+    Block &operator=(const Block &other) = default;
+
+    const std::bitset<DATA_BITS> &data_at(const int row) const {
+        return row == 0 ? data_A : row == 1 ? data_B : row == 2 ? data_C : data_D;
+    }
+
+    const std::bitset<CRC_BITS> &crc_at(const int row) const {
+        return row == 0 ? crc_A : row == 1 ? crc_B : row == 2 ? crc_C : crc_D;
+    }
+
+    Block copy() const {
+        return Block(
+                this->data_A,
+                this->data_B,
+                this->data_C,
+                this->data_D,
+                this->crc_A,
+                this->crc_B,
+                this->crc_C,
+                this->crc_D
+        );
+    }
+};
+
+/**
+ * @brief Row in which each offset word was found, -1 while not found.
+ */
+class GroupOffsets {
+public:
+    int row_of_offset[BLOCK_PARTS_COUNT] = {-1, -1, -1, -1};
+    int checked_rows = 0;
+};
+
+/**
+ * @brief State of one station, assembled from successive groups.
+ */
+class Station {
+public:
+    uint16_t program_id = 0;
+
+    // Block B flags of the last decoded group
+    uint8_t tp = 0;
+    uint8_t pty = 0;
+    uint8_t ta = 0;
+    uint8_t ms = 0;
+    uint8_t di = 0;
+    uint8_t ab_flag = 0;
+
+    // AF codes of the segment 0 group, shown while no AF list was received
+    uint8_t af1 = 0;
+    uint8_t af2 = 0;
+
+    // AF lists (method A and B) assembled from the AF pairs of all 0A groups
+    AfAssembler af;
+
+    // Program Service (0A), one bit per received segment
+    char program_service[Group0A::segments * Group0A::chars_per_segment];
+    uint8_t program_service_segments = 0;
+
+    // Radio Text (2A), one bit per received segment
+    char radio_text[Group2A::segments * Group2A::chars_per_segment];
+    uint16_t radio_text_segments = 0;
+    uint16_t radio_text_received = 0; // Segments of the current text (A/B flag), kept across records
+    uint8_t radio_text_end = Group2A::segments; // Segments up to the one with the end of text marker
+
+    // Content changed since the last emitted 0A/2A record
+    bool changed_0A = true;
+    bool changed_2A = true;
+
+    // Traffic Message Channel (8A), multi-group messages in reassembly and the last complete message
+    TmcAssembler tmc;
+    TmcMessage tmc_message;
+    bool changed_8A = true;
+
+    // Open Data Applications (3A): AID registered for each group type index, 0 if none
+    uint16_t oda_aid[GROUP_TYPE_COUNT] = {};
+
+    // RadioText Plus, tags of the RT+ ODA applied to the Radio Text
+    RtPlus rtplus;
+
+    // Other network of the last EON (14A/14B) group, the links themselves are kept in Program::eon
+    uint16_t eon_other_pi = 0;
+
+    Station() {
+        std::memset(program_service, ' ', sizeof(program_service));
+        std::memset(radio_text, ' ', sizeof(radio_text));
+    }
+};
+
+/**
+ * @brief Class that holds global variables for the whole program
+ */
+class Program {
+private:
+    StationTable<Station> stations;
+    LatencyRecorder latency;
+    GroupCache group_cache;
+    GroupFilter filter;
+    CaptureWriter *capture_writer = nullptr;
+    uint64_t biphase_invalid = 0; // Invalid half-symbol pairs ("00" or "11")
+    BlockSync *block_sync = nullptr; // Only for demodulated input
+    MpxDemodulator *mpx_demodulator = nullptr;
+    uint32_t stream_group_index = 0;
+    uint64_t stream_ingest = 0;
+    uint64_t stream_bits = 0; // Bits pushed to the block sync so far
+
+    // Capture records are stamped with stream time (position at the RDS bit rate) from the decoding start on
+    uint64_t capture_start = 0;
+
+    // Ingest timestamp of the group being decoded (0 outside of _decode_group), records it completes are
+    // measured from it
+    uint64_t completing_ingest = 0;
+
+    // Code tables of the TMC (8A) decoding, optional
+    TmcTable *tmc_events = nullptr;
+    TmcTable *tmc_locations = nullptr;
+    uint64_t tmc_messages = 0;
+    uint64_t tmc_tuning = 0;
+    uint64_t tmc_dropped = 0;
+
+    // Enhanced Other Networks (14A/14B) links of all stations
+    EonTable eon;
+    uint64_t eon_groups = 0;
+
+    // Station state snapshot (-sn): input offset of the next group, groups decoded, groups until the next snapshot
+    const char *snapshot_path = nullptr;
+    SnapshotInput snapshot_source{}; // The -f input
+    uint64_t snapshot_interval = 0;
+    uint64_t input_offset = 0;
+    uint64_t input_groups = 0;
+    uint64_t snapshot_countdown = 0;
+    uint64_t snapshots_written = 0;
+    std::size_t snapshot_restored = 0;
+
+    // Records go to stdout, per-station decoders of an IQ recording collect them for later
+    std::ostream *out = &std::cout;
+
+    /**
+     * @brief One FM channel of an IQ recording with its own decoder.
+     */
+    struct Channel {
+        double frequency; // Hz
+        std::size_t bin;
+        Program *decoder;
+        FmDemodulator fm;
+        std::ostringstream output;
+        std::vector<std::complex<float>> iq;
+        std::vector<float> mpx;
+        std::vector<uint8_t> bits; // Demodulated, not yet synced
+        BlockSyncCounters sync;
+
+        Channel(const double frequency, const std::size_t bin, Program *decoder, const double sample_rate)
+                : frequency(frequency), bin(bin), decoder(decoder), fm(sample_rate) {
+            decoder->out = &output;
+        }
+
+        ~Channel() {
+            delete decoder;
+        }
+    };
+
+    // Records decoded from a capture are prefixed with the time of their last group
+    bool print_timestamps = false;
+    uint64_t record_timestamp = 0;
+
+    /**
+     * @brief Raw 26-bit block words of the group as received, used as the cache key.
+     */
+    static GroupKey _group_key(const Block &group) {
+        GroupKey key;
+        key.words[0] = static_cast<uint32_t>((group.data_A.to_ulong() << CRC_BITS) | group.crc_A.to_ulong());
+        key.words[1] = static_cast<uint32_t>((group.data_B.to_ulong() << CRC_BITS) | group.crc_B.to_ulong());
+        key.words[2] = static_cast<uint32_t>((group.data_C.to_ulong() << CRC_BITS) | group.crc_C.to_ulong());
+        key.words[3] = static_cast<uint32_t>((group.data_D.to_ulong() << CRC_BITS) | group.crc_D.to_ulong());
+        return key;
+    }
+
+    /**
+     * @brief Stores the value and reports whether it differed from the previous one.
+     */
+    template<typename T, typename V>
+    static bool _update(T &field, const V value) {
+        if (field == static_cast<T>(value)) {
+            return false;
+        }
+        field = static_cast<T>(value);
+        return true;
+    }
+
+    /**
+     * @brief Wraps the raw block words of a group into a Block.
+     *
+     * @param raw The four 26-bit block words as received
+     * @param group_index Index of the group in the input (for tracing)
+     */
+    static Block _to_block(const RawGroup &raw, const uint32_t group_index) {
+        for (int row = 0; row < BLOCK_PARTS_COUNT; ++row) {
+            TRACE_EVENT(TraceEventType::RAW_BLOCK, row, raw.words[row], group_index);
+        }
+        return Block(raw.words[0] >> CRC_BITS, raw.words[1] >> CRC_BITS, raw.words[2] >> CRC_BITS, raw.words[3] >> CRC_BITS,
+                     raw.words[0], raw.words[1], raw.words[2], raw.words[3]);
+    }
+
+    /**
+     * @brief Extracts one group (4 blocks of data + checkword) from SIZE_GROUP '0'/'1' characters, read in place.
+     *
+     * @param text First character of the group
+     * @param group_index Index of the group in the input
+     */
+    static Block _get_group(const char *text, const uint32_t group_index) {
+        RawGroup raw;
+        if (!parse_ascii_group(text, raw)) {
+            TRACE_EVENT(TraceEventType::ERROR, static_cast<uint8_t>(TraceErrorCode::INPUT), group_index, 0);
+            throw std::invalid_argument("Invalid binary data in group " + std::to_string(group_index) + ". Expected only '0' and '1'.");
+        }
+        return _to_block(raw, group_index);
+    }
+
+    /**
+     * @brief Extracts one group from 13 bytes of a packed bitstream (MSB first), read in place.
+     */
+    static Block _get_packed_group(const uint8_t *bytes, const uint32_t group_index) {
+        RawGroup raw;
+        for (int block = 0; block < BLOCK_PARTS_COUNT; ++block) {
+            raw.words[block] = read_bits(bytes, block * BLOCK_ROW_SIZE, BLOCK_ROW_SIZE);
+        }
+        return _to_block(raw, group_index);
+    }
+
+    /**
+     * @brief Identifies the offset word of one row from its syndrome.
+     *
+     * @return Index of the offset (0=A..3=D) or -1 if the row does not match any offset (corrupted)
+     */
+    int _row_offset(const std::bitset<DATA_BITS> &data, const std::bitset<CRC_BITS> &crc, const uint8_t row) {
+        // Checkword of the data without offset XOR the received checkword leaves the offset word
+        const auto syndrome = calculate_crc(data, std::bitset<CRC_BITS>(0)) ^ crc;
+        TRACE_EVENT(TraceEventType::SYNDROME, row, (data.to_ulong() << CRC_BITS) | crc.to_ulong(), syndrome.to_ulong());
+
+        for (int offset = OFFSET_A; offset < BLOCK_PARTS_COUNT; ++offset) {
+            if (OFFSET_WORDS[offset] == syndrome.to_ulong()) {
+                return offset;
+            }
+        }
+        // Block C' of version B groups takes the place of block C
+        return syndrome.to_ulong() == OFFSET_WORD_C_PRIME ? OFFSET_C : -1;
+    }
+
+    /**
+     * @brief Locates the rows carrying offsets A up to last_offset.
+     * Rows are checked lazily in order, so A/B can be validated before C/D are looked at.
+     * The rows may be in any order, GroupOffsets maps every offset to its row.
+     *
+     * @param group The group to validate
+     * @param offsets Offsets found so far, updated
+     * @param last_offset Last offset that must be found (OFFSET_B or OFFSET_D)
+     * @param group_index Index of the group in the input (for tracing)
+     */
+    void _find_offsets(const Block &group, GroupOffsets &offsets, const int last_offset, const uint32_t group_index) {
+        auto is_found = [&offsets, last_offset]() {
+            for (int offset = OFFSET_A; offset <= last_offset; ++offset) {
+                if (offsets.row_of_offset[offset] < 0) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        while (!is_found() && offsets.checked_rows < BLOCK_PARTS_COUNT) {
+            const int row = offsets.checked_rows++;
+            const int offset = _row_offset(group.data_at(row), group.crc_at(row), static_cast<uint8_t>(row));
+            if (offset < 0) {
+                TRACE_EVENT(TraceEventType::ERROR, static_cast<uint8_t>(TraceErrorCode::CRC), group_index, row);
+                throw std::invalid_argument("CRC check failed - data is corrupted.");
+            }
+            if (offsets.row_of_offset[offset] >= 0) {
+                TRACE_EVENT(TraceEventType::ERROR, static_cast<uint8_t>(TraceErrorCode::OFFSETS), group_index, row);
+                throw std::invalid_argument("Bad data - not all offsets are unique.");
+            }
+            DEBUG_PRINT_LITE("offset: %c, row: %d%c", 'A' + offset, row, '\n');
+            TRACE_EVENT(TraceEventType::OFFSET, static_cast<uint8_t>(offset), group_index, row);
+            offsets.row_of_offset[offset] = row;
+        }
+
+        if (!is_found()) {
+            TRACE_EVENT(TraceEventType::ERROR, static_cast<uint8_t>(TraceErrorCode::OFFSETS), group_index, last_offset);
+            throw std::invalid_argument("Bad data - not all offsets are unique.");
+        }
+    }
+
+    /**
+     * @brief Writes G0 text (PS, RT) quoted and converted to UTF-8, without the spaces around it.
+     */
+    void _emit_text(const char *text, std::size_t size) {
+        while (size > 0 && G0_TO_UNICODE[static_cast<uint8_t>(text[size - 1])] == G0_SPACE) {
+            size--;
+        }
+        while (size > 0 && G0_TO_UNICODE[static_cast<uint8_t>(text[0])] == G0_SPACE) {
+            text++;
+            size--;
+        }
+        char utf8[Group2A::segments * Group2A::chars_per_segment * G0_UTF8_MAX];
+        *out << "\"";
+        out->write(utf8, static_cast<std::streamsize>(g0_to_utf8(text, size, utf8)));
+        *out << "\"" << std::endl;
+    }
+
+    /**
+     * @brief Records the output latency of an emitted record and its end-to-end latency from the ingest of the
+     * group that completed it. Records emitted without a completing group (end of input, eviction) have no
+     * end-to-end sample.
+     */
+    void _finish_emit(const uint64_t output_start) {
+        if (latency.enabled) {
+            const uint64_t emitted = latency_now();
+            latency.record(LatencyStage::OUTPUT, output_start, emitted);
+            if (completing_ingest != 0) {
+                latency.record(LatencyStage::END_TO_END, completing_ingest, emitted);
+            }
+        }
+    }
+
+    void _emit_timestamp() {
+        if (print_timestamps) {
+            *out << "TS: " << record_timestamp / 1000000 << "." << std::setw(6) << std::setfill('0')
+                      << record_timestamp % 1000000 << std::setfill(' ') << std::endl;
+        }
+    }
+
+    /**
+     * @brief Method A list as "AF: ...", every method B list as "AF <tuned>: ..." with regional variants marked.
+     */
+    void _emit_af_lists(const AfAssembler &af) {
+        if (af.has_method_a) {
+            *out << "AF:";
+            for (int i = 0; i < af.method_a.count; ++i) {
+                *out << (i == 0 ? " " : ", ");
+                af_print(*out, af.method_a.channels[i]);
+            }
+            *out << std::endl;
+        }
+        for (int list = 0; list < af.method_b_count; ++list) {
+            const AfList &method_b = af.method_b[list];
+            *out << "AF ";
+            af_print(*out, method_b.tuned);
+            *out << ":";
+            for (int i = 0; i < method_b.count; ++i) {
+                *out << (i == 0 ? " " : ", ");
+                af_print(*out, method_b.channels[i] & ~AF_CHANNEL_REGIONAL);
+                if (method_b.channels[i] & AF_CHANNEL_REGIONAL) {
+                    *out << " (regional)";
+                }
+            }
+            *out << std::endl;
+        }
+    }
+
+    void _emit_0A(Station &station) {
+        const uint64_t output_start = latency.enabled ? latency_now() : 0;
+
+        _emit_timestamp();
+        *out << "PI: " << station.program_id << std::endl;
+        *out << "GT: 0A" << std::endl;
+        *out << "TP: " << (station.tp == 1 ? "1" : "0") << std::endl;
+        *out << "PTY: " << static_cast<int>(station.pty) << std::endl;
+        *out << "TA: " << (station.ta == 1 ? "Active" : "Inactive") << std::endl;
+        *out << "MS: " << (station.ms == 1 ? "Music" : "Speech") << std::endl;
+        *out << "DI: " << static_cast<int>(station.di) << std::endl;
+
+        // AF codes are formatted to MHz only here
+        if (station.af.has_lists()) {
+            _emit_af_lists(station.af);
+        } else {
+            *out << "AF: ";
+            af_print(*out, station.af1);
+            *out << ", ";
+            af_print(*out, station.af2);
+            *out << std::endl;
+        }
+
+        *out << "PS: ";
+        _emit_text(station.program_service, sizeof(station.program_service));
+
+        station.program_service_segments = 0;
+        station.changed_0A = false;
+        _finish_emit(output_start);
+    }
+
+    void _emit_2A(Station &station) {
+        const uint64_t output_start = latency.enabled ? latency_now() : 0;
+
+        _emit_timestamp();
+        *out << "PI: " << station.program_id << std::endl;
+        *out << "GT: 2A" << std::endl;
+        *out << "TP: " << (station.tp == 1 ? "1" : "0") << std::endl;
+        *out << "PTY: " << static_cast<int>(station.pty) << std::endl;
+        *out << "A/B: " << (station.ab_flag == 1 ? "1" : "0") << std::endl;
+
+        // Characters after the end of text marker are left over from a longer text
+        const void *end = std::memchr(station.radio_text, Group2A::end_of_text, sizeof(station.radio_text));
+        *out << "RT: ";
+        _emit_text(station.radio_text, end != nullptr ? static_cast<const char *>(end) - station.radio_text : sizeof(station.radio_text));
+
+        station.radio_text_segments = 0;
+        station.changed_2A = false;
+        _finish_emit(output_start);
+    }
+
+    /**
+     * @brief Code and its text from the table, just the code without a table or when the table does not list it.
+     */
+    static void _emit_code(std::ostream &stream, const uint32_t code, const TmcTable *table) {
+        stream << code;
+        const char *text = table != nullptr ? table->lookup(code) : nullptr;
+        if (text != nullptr) {
+            stream << " \"" << text << "\"";
+        }
+        stream << std::endl;
+    }
+
+    void _emit_8A(Station &station) {
+        const uint64_t output_start = latency.enabled ? latency_now() : 0;
+        const TmcMessage &message = station.tmc_message;
+
+        _emit_timestamp();
+        *out << "PI: " << station.program_id << std::endl;
+        *out << "GT: 8A" << std::endl;
+        *out << "TP: " << (station.tp == 1 ? "1" : "0") << std::endl;
+        *out << "PTY: " << static_cast<int>(station.pty) << std::endl;
+        if (message.multi_group) {
+            *out << "TMC: Multi-group, CI " << static_cast<int>(message.continuity_index) << std::endl;
+        } else {
+            *out << "TMC: Single group" << std::endl;
+        }
+        *out << "Event: ";
+        _emit_code(*out, message.event, tmc_events);
+        *out << "Location: ";
+        _emit_code(*out, message.location, tmc_locations);
+        *out << "Direction: " << (message.negative ? "Negative" : "Positive") << std::endl;
+        *out << "Extent: " << static_cast<int>(message.extent) << std::endl;
+        *out << "Duration: " << static_cast<int>(message.duration) << std::endl;
+        if (!message.multi_group) {
+            *out << "Diversion: " << (message.diversion ? "1" : "0") << std::endl;
+        }
+        for (const auto &field: message.fields) {
+            if (field.label == TMC_LABEL_DURATION) {
+                continue;
+            }
+            *out << TMC_FIELD_NAMES[field.label] << ": ";
+            if (field.label == TMC_LABEL_ADDITIONAL_EVENT) {
+                _emit_code(*out, field.value, tmc_events);
+            } else {
+                *out << field.value << std::endl;
+            }
+        }
+
+        station.changed_8A = false;
+        _finish_emit(output_start);
+    }
+
+    /**
+     * @brief Group type as written in the records, from its index ("11A").
+     */
+    static std::string _group_name(const int index) {
+        return std::to_string(index / 2) + (index % 2 == 0 ? "A" : "B");
+    }
+
+    void _emit_3A(Station &station, const int application_group) {
+        const uint64_t output_start = latency.enabled ? latency_now() : 0;
+        const uint16_t aid = station.oda_aid[application_group];
+
+        _emit_timestamp();
+        *out << "PI: " << station.program_id << std::endl;
+        *out << "GT: 3A" << std::endl;
+        *out << "TP: " << (station.tp == 1 ? "1" : "0") << std::endl;
+        *out << "PTY: " << static_cast<int>(station.pty) << std::endl;
+        *out << "ODA: " << _group_name(application_group) << std::endl;
+        *out << "AID: " << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << aid
+             << std::dec << std::nouppercase << std::setfill(' ') << (aid == RTPLUS_AID ? " (RT+)" : "") << std::endl;
+
+        _finish_emit(output_start);
+    }
+
+    void _emit_rtplus(Station &station, const int group_index) {
+        const uint64_t output_start = latency.enabled ? latency_now() : 0;
+        const RtPlus &rtplus = station.rtplus;
+
+        _emit_timestamp();
+        *out << "PI: " << station.program_id << std::endl;
+        *out << "GT: " << _group_name(group_index) << std::endl;
+        *out << "TP: " << (station.tp == 1 ? "1" : "0") << std::endl;
+        *out << "PTY: " << static_cast<int>(station.pty) << std::endl;
+        *out << "RT+ Toggle: " << static_cast<int>(rtplus.toggle) << std::endl;
+        *out << "RT+ Running: " << (rtplus.running == 1 ? "1" : "0") << std::endl;
+        for (const auto &item: rtplus.items) {
+            *out << RTPLUS_CONTENT_TYPE_NAMES[item.type] << ": ";
+            _emit_text(item.text.data(), item.text.size());
+        }
+
+        _finish_emit(output_start);
+    }
+
+    void _emit_14A(Station &station, EonEntry &link) {
+        const uint64_t output_start = latency.enabled ? latency_now() : 0;
+
+        _emit_timestamp();
+        *out << "PI: " << station.program_id << std::endl;
+        *out << "GT: 14A" << std::endl;
+        *out << "TP: " << (station.tp == 1 ? "1" : "0") << std::endl;
+        *out << "PTY: " << static_cast<int>(station.pty) << std::endl;
+        *out << "ON PI: " << link.other_pi << std::endl;
+        *out << "ON TP: " << (link.tp == 1 ? "1" : "0") << std::endl;
+        if (link.has_pty) {
+            *out << "ON PTY: " << static_cast<int>(link.pty) << std::endl;
+            *out << "ON TA: " << (link.ta == 1 ? "Active" : "Inactive") << std::endl;
+        }
+        if (link.af.has_method_a) {
+            *out << "ON AF:";
+            for (int i = 0; i < link.af.method_a.count; ++i) {
+                *out << (i == 0 ? " " : ", ");
+                af_print(*out, link.af.method_a.channels[i]);
+            }
+            *out << std::endl;
+        }
+        if (link.mapped_count > 0) {
+            *out << "ON Mapped:";
+            for (int i = 0; i < link.mapped_count; ++i) {
+                *out << (i == 0 ? " " : ", ");
+                af_print(*out, link.mapped[i].tuned);
+                *out << " -> ";
+                af_print(*out, link.mapped[i].mapped);
+            }
+            *out << std::endl;
+        }
+        if (link.has_linkage) {
+            *out << "ON Linkage: " << link.linkage << std::endl;
+        }
+        if (link.has_pin) {
+            *out << "ON PIN: " << link.pin << std::endl;
+        }
+
+        *out << "ON PS: ";
+        _emit_text(link.program_service, sizeof(link.program_service));
+
+        link.program_service_segments = 0;
+        link.changed = false;
+        _finish_emit(output_start);
+    }
+
+    void _emit_14B(Station &station, const EonEntry &link) {
+        const uint64_t output_start = latency.enabled ? latency_now() : 0;
+
+        _emit_timestamp();
+        *out << "PI: " << station.program_id << std::endl;
+        *out << "GT: 14B" << std::endl;
+        *out << "TP: " << (station.tp == 1 ? "1" : "0") << std::endl;
+        *out << "PTY: " << static_cast<int>(station.pty) << std::endl;
+        *out << "ON PI: " << link.other_pi << std::endl;
+        *out << "ON TP: " << (link.tp == 1 ? "1" : "0") << std::endl;
+        *out << "ON TA: " << (link.ta == 1 ? "Active" : "Inactive") << std::endl;
+
+        _finish_emit(output_start);
+    }
+
+    /**
+     * @brief Decodes one validated group into the state of its station, emits the record once it is complete.
+     *
+     * @param group Information words of blocks A, B, C, D
+     * @param ingest Timestamp of the group ingest
+     */
+    void _decode_group(const uint16_t *group, const uint64_t ingest) {
+        const uint64_t decode_start = latency.enabled ? latency_now() : 0;
+
+        //////////////////////////
+        /// Decode Block A (Program Identifier - PI)
+        //////////////////////////
+        const uint16_t program_id = group[0];
+        const uint16_t block_B = group[1];
+
+        // Group Type (GT): 4 bits type + 1 bit version (A/B)
+        const auto group_type = static_cast<uint8_t>(GroupTypeField::get(block_B));
+        const auto version = static_cast<uint8_t>(VersionField::get(block_B));
+        TRACE_EVENT(TraceEventType::GROUP, group_type | (version << 4), program_id, block_B);
+
+        auto &station = stations.at(program_id, [this](Station &evicted) {
+            _flush(evicted);
+        });
+        station.program_id = program_id;
+        completing_ingest = ingest;
+
+        if (group_type == Group0A::type && version == Group0A::version) {
+            const bool complete = decode_0A(group, station);
+            if (latency.enabled) {
+                latency.record(LatencyStage::DECODE, decode_start, latency_now());
+            }
+            if (complete && station.changed_0A) {
+                _emit_0A(station);
+            } else if (complete) {
+                // Same content as the last record - nothing to format
+                station.program_service_segments = 0;
+            }
+        } else if (group_type == Group2A::type && version == Group2A::version) {
+            const bool complete = decode_2A(group, station);
+            if (latency.enabled) {
+                latency.record(LatencyStage::DECODE, decode_start, latency_now());
+            }
+            if (complete && station.changed_2A) {
+                _emit_2A(station);
+            } else if (complete) {
+                // Same content as the last record - nothing to format
+                station.radio_text_segments = 0;
+            }
+
+            // RT+ items follow the text they are cut from
+            const int rtplus_group = _rtplus_group(station);
+            if (rtplus_group >= 0 && station.rtplus.apply(station.radio_text, sizeof(station.radio_text),
+                                                          station.radio_text_received, Group2A::chars_per_segment)) {
+                _emit_rtplus(station, rtplus_group);
+            }
+        } else if (group_type == Group3A::type && version == Group3A::version) {
+            const int application_group = decode_3A(group, station);
+            if (latency.enabled) {
+                latency.record(LatencyStage::DECODE, decode_start, latency_now());
+            }
+            if (application_group >= 0) {
+                _emit_3A(station, application_group);
+            }
+        } else if (group_type == Group8A::type && version == Group8A::version) {
+            const bool complete = decode_8A(group, station);
+            if (latency.enabled) {
+                latency.record(LatencyStage::DECODE, decode_start, latency_now());
+            }
+            if (complete && station.changed_8A) {
+                _emit_8A(station);
+            }
+        } else if (group_type == Group14A::type && version == Group14A::version) {
+            const bool complete = decode_14A(group, station);
+            if (latency.enabled) {
+                latency.record(LatencyStage::DECODE, decode_start, latency_now());
+            }
+            EonEntry &link = eon.at(station.program_id, station.eon_other_pi);
+            if (complete && link.changed) {
+                _emit_14A(station, link);
+            } else if (complete) {
+                // Same content as the last record - nothing to format
+                link.program_service_segments = 0;
+            }
+        } else if (group_type == Group14B::type && version == Group14B::version) {
+            // TA/TP of the other network are emitted at once, that is when the receiver has to switch
+            const bool changed = decode_14B(group, station);
+            if (latency.enabled) {
+                latency.record(LatencyStage::DECODE, decode_start, latency_now());
+            }
+            if (changed) {
+                _emit_14B(station, eon.at(station.program_id, station.eon_other_pi));
+            }
+        } else if (station.oda_aid[group_type_index(block_B)] == RTPLUS_AID) {
+            const bool changed = decode_rtplus(group, station);
+            if (latency.enabled) {
+                latency.record(LatencyStage::DECODE, decode_start, latency_now());
+            }
+            if (changed) {
+                _emit_rtplus(station, group_type_index(block_B));
+            }
+        }
+        completing_ingest = 0;
+    }
+
+    /**
+     * @brief Validates one received group and passes it on to decoding.
+     *
+     * @param group The group as received (rows in any order)
+     * @param group_index Index of the group in the input (for tracing)
+     * @param ingest Timestamp of the group ingest
+     * @param synced Timestamp of the end of the sync stage
+     */
+    void _process_group(const Block &group, const uint32_t group_index, const uint64_t ingest, const uint64_t synced) {
+        //////////////////////////
+        /// CRC and Block Order Validation
+        //////////////////////////
+        // Exact repeats of an already validated group skip the validation
+        const auto key = _group_key(group);
+        const auto cached = group_cache.lookup(key);
+        uint16_t words[BLOCK_PARTS_COUNT];
+        bool accepted;
+        if (cached != nullptr) {
+            std::memcpy(words, cached->data, sizeof(words));
+            accepted = filter.accepts(words[0], words[1]);
+        } else {
+            // Blocks A and B first, the filter only needs PI and block B
+            GroupOffsets offsets;
+            this->_find_offsets(group, offsets, OFFSET_B, group_index);
+            words[0] = static_cast<uint16_t>(group.data_at(offsets.row_of_offset[OFFSET_A]).to_ulong());
+            words[1] = static_cast<uint16_t>(group.data_at(offsets.row_of_offset[OFFSET_B]).to_ulong());
+            accepted = filter.accepts(words[0], words[1]);
+
+            // Blocks C and D only for groups somebody asked for
+            if (accepted) {
+                this->_find_offsets(group, offsets, OFFSET_D, group_index);
+                words[2] = static_cast<uint16_t>(group.data_at(offsets.row_of_offset[OFFSET_C]).to_ulong());
+                words[3] = static_cast<uint16_t>(group.data_at(offsets.row_of_offset[OFFSET_D]).to_ulong());
+                group_cache.insert(key, words[0], words[1], words[2], words[3]);
+            }
+        }
+        if (latency.enabled) {
+            latency.record(LatencyStage::SYNC, ingest, synced);
+            latency.record(LatencyStage::CORRECTION, synced, latency_now());
+        }
+        if (!accepted) {
+            return;
+        }
+
+        if (capture_writer != nullptr) {
+            // Demodulated input: the group ended with the last bit pushed, otherwise groups follow back to back
+            const uint64_t position = block_sync != nullptr ? stream_bits - SIZE_GROUP : static_cast<uint64_t>(group_index) * SIZE_GROUP;
+            capture_writer->write(capture_start + static_cast<uint64_t>(position * 1000000.0 / BIT_RATE), words);
+        }
+
+        //////////////////////////
+        /// Decode
+        //////////////////////////
+        this->_decode_group(words, ingest);
+
+        if (latency_report_requested) {
+            latency_report_requested = 0;
+            latency.report(std::cerr);
+        }
+    }
+
+    /**
+     * @brief Decodes the '0'/'1' string given on the command line.
+     */
+    void _decode_binary_string(const std::string &data) {
+        const int group_count = static_cast<int>(data.size() / SIZE_GROUP);
+        for (int i = 0; i < group_count; ++i) {
+            // NOTE: The whole input is available at once, the group is ingested when its bits are taken from it
+            const uint64_t ingest = latency.enabled ? latency_now() : 0;
+
+            //////////////////////////
+            /// Sync
+            //////////////////////////
+            const auto group = _get_group(data.c_str() + i * SIZE_GROUP, i);
+            const uint64_t synced = latency.enabled ? latency_now() : 0;
+
+            this->_process_group(group, i, ingest, synced);
+        }
+    }
+
+    /**
+     * @brief Undoes biphase coding of '0'/'1' half-symbols, the result must be whole groups.
+     */
+    std::string _biphase_decode(const char *text, const std::size_t size) {
+        uint64_t invalid = 0;
+        const auto data = biphase_decode_ascii(text, size, invalid);
+        biphase_invalid += invalid;
+        if (data.empty() || data.size() % SIZE_GROUP) {
+            throw std::invalid_argument("Invalid binary data size after biphase decoding: " + std::to_string(data.size()) + ". Expected a multiple of " + std::to_string(SIZE_GROUP));
+        }
+        return data;
+    }
+
+    /**
+     * @brief Decodes a packed bitstream (13 bytes per group), read in place.
+     *
+     * @param window Mapping to advance the read-ahead window of, nullptr if the bytes are not mapped
+     * @param start Offset of the first group to decode (resuming from a snapshot)
+     */
+    void _decode_packed(const uint8_t *bytes, const std::size_t length, MappedFile *window, const std::size_t start = 0) {
+        if (length % RDSZ_LITERAL_SIZE) {
+            throw std::invalid_argument("Invalid packed data size: " + std::to_string(length) + ". Expected a multiple of " + std::to_string(RDSZ_LITERAL_SIZE) + " bytes");
+        }
+        const uint32_t group_count = static_cast<uint32_t>(length / RDSZ_LITERAL_SIZE);
+        for (uint32_t i = static_cast<uint32_t>(start / RDSZ_LITERAL_SIZE); i < group_count; ++i) {
+            if (window != nullptr) {
+                window->advance(i * RDSZ_LITERAL_SIZE);
+            }
+            const uint64_t ingest = latency.enabled ? latency_now() : 0;
+            const auto group = _get_packed_group(bytes + i * RDSZ_LITERAL_SIZE, i);
+            const uint64_t synced = latency.enabled ? latency_now() : 0;
+            this->_process_group(group, i, ingest, synced);
+            this->_snapshot_tick((i + 1) * static_cast<uint64_t>(RDSZ_LITERAL_SIZE));
+        }
+    }
+
+    /**
+     * @brief Decodes a bitstream file through a memory mapping, groups are extracted in place without copying the file.
+     * ASCII files may contain whitespace (line breaks) between groups, packed files are 13 bytes (104 bits) per group.
+     */
+    void _decode_file(const std::string &path, const bool packed) {
+        MappedFile file(path);
+        if (file.length() == 0) {
+            throw std::invalid_argument("Input file is empty: " + path);
+        }
+        file.advise_sequential();
+        file.advise_hugepage();
+
+        const auto text = reinterpret_cast<const char *>(file.bytes());
+        const std::size_t size = file.length();
+
+        if (args->get_biphase()) {
+            if (!packed) {
+                this->_decode_binary_string(this->_biphase_decode(text, size));
+                return;
+            }
+            // Packed symbols must start on a symbol boundary, 2 symbol bytes per data byte
+            if (size % (2 * RDSZ_LITERAL_SIZE)) {
+                throw std::invalid_argument("Invalid packed symbol data size: " + std::to_string(size) + ". Expected a multiple of " + std::to_string(2 * RDSZ_LITERAL_SIZE) + " bytes");
+            }
+            std::vector<uint8_t> bits(size / 2);
+            uint8_t state = 0;
+            biphase_invalid += biphase_decode(file.bytes(), bits.size(), bits.data(), state);
+            this->_decode_packed(bits.data(), bits.size(), nullptr);
+            return;
+        }
+
+        if (input_offset > size || (packed && input_offset % RDSZ_LITERAL_SIZE)) {
+            throw std::invalid_argument("Snapshot offset " + std::to_string(input_offset) + " does not fit the input: " + path);
+        }
+        if (packed) {
+            this->_decode_packed(file.bytes(), size, &file, static_cast<std::size_t>(input_offset));
+            return;
+        }
+
+        std::size_t position = static_cast<std::size_t>(input_offset);
+        auto group_index = static_cast<uint32_t>(input_groups);
+        while (true) {
+            while (position < size && std::isspace(static_cast<unsigned char>(text[position]))) {
+                position++;
+            }
+            if (position == size) {
+                break;
+            }
+            file.advance(position);
+            const uint64_t ingest = latency.enabled ? latency_now() : 0;
+
+            //////////////////////////
+            /// Sync
+            //////////////////////////
+            const char *group_text = text + position;
+            char split_group[SIZE_GROUP];
+            const void *line_break = std::memchr(group_text, '\n', size - position < SIZE_GROUP ? size - position : SIZE_GROUP);
+            if (size - position >= SIZE_GROUP && line_break == nullptr) {
+                position += SIZE_GROUP;
+            } else {
+                // NOTE: Only a group split by a line break is copied, to join its parts
+                int count = 0;
+                for (; position < size && count < SIZE_GROUP; ++position) {
+                    if (!std::isspace(static_cast<unsigned char>(text[position]))) {
+                        split_group[count++] = text[position];
+                    }
+                }
+                if (count < SIZE_GROUP) {
+                    TRACE_EVENT(TraceEventType::ERROR, static_cast<uint8_t>(TraceErrorCode::INPUT), group_index, count);
+                    throw std::invalid_argument("Invalid binary data size: the last group has only " + std::to_string(count) + " bits. Expected: " + std::to_string(SIZE_GROUP));
+                }
+                group_text = split_group;
+            }
+            const auto group = _get_group(group_text, group_index);
+            const uint64_t synced = latency.enabled ? latency_now() : 0;
 
-    Block copy() const {
-        return Block(
-                this->data_A,
-                this->data_B,
-                this->data_C,
-                this->data_D,
-                this->crc_A,
-                this->crc_B,
-                this->crc_C,
-                this->crc_D
-        );
+            this->_process_group(group, group_index++, ingest, synced);
+            this->_snapshot_tick(position);
+        }
     }
-};
 
-/**
- * @brief Class that holds global variables for the whole program
- */
-class Program {
-private:
-    auto _convert_to_bitset_size_0A(const std::string binary_data) {
-        return std::bitset<SIZE_0A>(binary_data);
+    /**
+     * @brief Prepares demodulation of a continuous MPX stream fed by _stream_samples or _demodulate.
+     */
+    void _start_stream(const uint32_t sample_rate) {
+        mpx_demodulator = new MpxDemodulator(sample_rate);
     }
 
-    auto _convert_to_bitset_size_2A(const std::string binary_data) {
-        return std::bitset<SIZE_2A>(binary_data);
+    /**
+     * @brief Demodulates MPX samples, the recovered bits are appended to `bits` (synced and decoded elsewhere).
+     */
+    void _demodulate(const float *samples, const std::size_t count, std::vector<uint8_t> &bits) {
+        mpx_demodulator->process(samples, count, [&bits](const int bit) {
+            bits.push_back(static_cast<uint8_t>(bit));
+        });
     }
 
-    bool _is_group_type_0A(const std::string data) {
-        const auto is = data.size() / SIZE_0A == 1;
-        return is;
+    /**
+     * @brief Decodes one group found by the block sync.
+     */
+    void _stream_group(const RawGroup &raw_group) {
+        const uint64_t synced = latency.enabled ? latency_now() : 0;
+        this->_process_group(_to_block(raw_group, stream_group_index), stream_group_index, stream_ingest, synced);
+        stream_group_index++;
     }
 
-    bool _is_group_type_2A(const std::string data) {
-        const auto is = data.size() / SIZE_2A == 1;
-        return is;
+    /**
+     * @brief Demodulates MPX samples and decodes the groups found in the recovered bitstream.
+     * Groups with uncorrectable errors are dropped by the block sync, only error-free groups are decoded.
+     */
+    void _stream_samples(const float *samples, const std::size_t count) {
+        // NOTE: Groups are ingested with the block of samples that completes them
+        stream_ingest = latency.enabled ? latency_now() : 0;
+        auto on_group = [this](const RawGroup &raw_group) {
+            this->_stream_group(raw_group);
+        };
+        mpx_demodulator->process(samples, count, [this, &on_group](const int bit) {
+            stream_bits++;
+            block_sync->push(bit, on_group);
+        });
     }
 
-    template<std::size_t N>
-    auto _get_blocks(const std::bitset<N> data, const int block_count) {
-        std::vector<Block> blocks;
-//        print_packet(data);
+    /**
+     * @brief Decodes a file of soft bits (one int8 per bit, see BlockSync::push_soft).
+     * The stream does not have to start on a group boundary, blocks are corrected using the bit reliabilities.
+     */
+    void _decode_soft(const std::string &path) {
+        MappedFile file(path);
+        file.advise_sequential();
+        block_sync = new BlockSync(args->get_chase_bits());
+
+        auto on_group = [this](const RawGroup &raw_group) {
+            this->_stream_group(raw_group);
+        };
+        const auto *values = reinterpret_cast<const int8_t *>(file.bytes());
+        for (std::size_t offset = 0; offset < file.length(); offset += MAPPED_FILE_CHUNK) {
+            file.advance(offset);
+            stream_ingest = latency.enabled ? latency_now() : 0;
+            const std::size_t end = std::min(file.length(), offset + MAPPED_FILE_CHUNK);
+            for (std::size_t i = offset; i < end; ++i) {
+                stream_bits++;
+                block_sync->push_soft(values[i], on_group);
+            }
+        }
+    }
 
-        // Parse
-        for (int i = 0; i < block_count; i += 1) {
-//            DEBUG_PRINT_LITE("i: %d%c", i, '\n');
-            // Extract blocks in reverse order (D to A)
-            // Block A
-            const int row_A_start = i * BLOCK_ROW_SIZE * BLOCKS_COUNT_IN_0A;
-            std::bitset<DATA_BITS> data_A = std::bitset<DATA_BITS>(data.to_string().substr(row_A_start, DATA_BITS));
-            std::bitset<CRC_BITS> crc_A = std::bitset<CRC_BITS>(data.to_string().substr(row_A_start + DATA_BITS, CRC_BITS));
+    /**
+     * @brief Demodulates an MPX sample file and decodes it.
+     */
+    void _decode_mpx(const std::string &path) {
+        const bool raw = args->get_raw();
+        SampleReader reader(path, raw, raw ? args->get_sample_rate() : 0);
+        this->_start_stream(reader.sample_rate());
+        block_sync = new BlockSync(args->get_chase_bits());
+
+        std::vector<float> samples(MPX_CHUNK);
+        for (std::size_t count = reader.read(samples.data(), samples.size()); count > 0; count = reader.read(samples.data(), samples.size())) {
+            this->_stream_samples(samples.data(), count);
+        }
+    }
 
-            // Block B
-            const int row_B_start = row_A_start + BLOCK_ROW_SIZE;
-            std::bitset<DATA_BITS> data_B = std::bitset<DATA_BITS>(data.to_string().substr(row_B_start, DATA_BITS));
-            std::bitset<CRC_BITS> crc_B = std::bitset<CRC_BITS>(data.to_string().substr(row_B_start + DATA_BITS, CRC_BITS));
+    /**
+     * @brief Finds the active FM channels: power IQ_DETECT_THRESHOLD over the lower quartile
+     * of all channels (the noise floor) and not below a neighbour
+     * (a strong station also leaks into the overlapping neighbouring channels). Channels at the band edges are skipped.
+     */
+    std::vector<std::size_t> _detect_channels(IqReader &reader, const double sample_rate, const std::size_t channel_count, const std::size_t decimation) {
+        PolyphaseChannelizer detector(sample_rate, channel_count, decimation);
+        std::vector<double> power(channel_count, 0.0);
+        std::vector<float> i_in(IQ_CHUNK), q_in(IQ_CHUNK);
+        auto remaining = static_cast<std::size_t>(IQ_DETECT_SECONDS * sample_rate);
+        while (remaining > 0) {
+            const std::size_t count = reader.read(i_in.data(), q_in.data(), std::min(remaining, i_in.size()));
+            if (count == 0) {
+                break;
+            }
+            remaining -= count;
+            detector.process(i_in.data(), q_in.data(), count, [&power, channel_count](const std::complex<float> *spectrum) {
+                for (std::size_t k = 0; k < channel_count; ++k) {
+                    power[k] += std::norm(spectrum[k]);
+                }
+            });
+        }
+        reader.rewind();
+
+        std::vector<double> sorted(power);
+        std::sort(sorted.begin(), sorted.end());
+        const double floor = sorted[channel_count / 4];
+
+        std::vector<std::size_t> active;
+        for (std::size_t k = 0; k < channel_count; ++k) {
+            const std::size_t offset = k < (channel_count + 1) / 2 ? k : channel_count - k;
+            const double left = power[(k + channel_count - 1) % channel_count];
+            const double right = power[(k + 1) % channel_count];
+            if (2 * offset + 2 <= channel_count && power[k] > IQ_DETECT_THRESHOLD * floor && power[k] >= left && power[k] >= right) {
+                active.push_back(k);
+            }
+        }
+        return active;
+    }
 
-            // Block C
-            const int row_C_start = row_B_start + BLOCK_ROW_SIZE;
-            std::bitset<DATA_BITS> data_C = std::bitset<DATA_BITS>(data.to_string().substr(row_C_start, DATA_BITS));
-            std::bitset<CRC_BITS> crc_C = std::bitset<CRC_BITS>(data.to_string().substr(row_C_start + DATA_BITS, CRC_BITS));
+    /**
+     * @brief Decodes every FM station of a wideband IQ recording. One channelizer (and one FFT per output sample)
+     * serves all stations, FM demodulation and RDS decoding of the stations run in parallel on a thread pool.
+     */
+    void _decode_iq(const std::string &path) {
+        const uint32_t sample_rate = args->get_iq_sample_rate();
+        const double center = args->get_center_frequency();
+        const uint32_t spacing = args->get_channel_spacing();
+        if (sample_rate % spacing != 0) {
+            throw std::invalid_argument("IQ sample rate must be a multiple of the channel spacing " + std::to_string(spacing) + " Hz");
+        }
+        const std::size_t channel_count = sample_rate / spacing;
+        std::size_t decimation = sample_rate / CHANNELIZER_TARGET_RATE;
+        while (decimation > 1 && sample_rate % decimation != 0) {
+            decimation--;
+        }
+        if (decimation == 0 || sample_rate / decimation > MPX_SAMPLE_RATE_MAX) {
+            throw std::invalid_argument("IQ sample rate " + std::to_string(sample_rate) + " Hz is out of range");
+        }
+        const uint32_t channel_rate = static_cast<uint32_t>(sample_rate / decimation);
 
-            // Block D
-            const int data_D_start = row_C_start + BLOCK_ROW_SIZE;
-            std::bitset<DATA_BITS> data_D = std::bitset<DATA_BITS>(data.to_string().substr(data_D_start, DATA_BITS));
-            std::bitset<CRC_BITS> crc_D = std::bitset<CRC_BITS>(data.to_string().substr(data_D_start + DATA_BITS, CRC_BITS));
+        IqReader reader(path, args->get_iq_format());
+        const auto bins = this->_detect_channels(reader, sample_rate, channel_count, decimation);
+        if (bins.empty()) {
+            throw std::invalid_argument("No active FM channels found in " + path);
+        }
 
-            // Add to the vectors
-            blocks.emplace_back(data_A, data_B, data_C, data_D, crc_A, crc_B, crc_C, crc_D);
+        std::vector<std::unique_ptr<Channel>> channels;
+        for (const auto bin: bins) {
+            const double offset = bin < (channel_count + 1) / 2 ? static_cast<double>(bin) : static_cast<double>(bin) - static_cast<double>(channel_count);
+            auto *decoder = new Program(new Args(*args));
+            decoder->_setup(false);
+            decoder->_start_stream(channel_rate);
+            channels.emplace_back(new Channel(center + offset * spacing, bin, decoder, channel_rate));
+        }
+        std::sort(channels.begin(), channels.end(), [](const std::unique_ptr<Channel> &a, const std::unique_ptr<Channel> &b) {
+            return a->frequency < b->frequency;
+        });
+
+        if (channels.size() <= BitsliceLanes<uint64_t>::count) {
+            this->_run_channels<uint64_t>(reader, sample_rate, channel_count, decimation, channels);
+        } else {
+            this->_run_channels<bitslice_u256>(reader, sample_rate, channel_count, decimation, channels);
+        }
 
-//            DEBUG_PRINT_LITE("Block A: %s | %s%c", data_A.to_string().c_str(), crc_A.to_string().c_str(), '\n');
-//            DEBUG_PRINT_LITE("Block B: %s | %s%c", data_B.to_string().c_str(), crc_B.to_string().c_str(), '\n');
-//            DEBUG_PRINT_LITE("Block C: %s | %s%c", data_C.to_string().c_str(), crc_C.to_string().c_str(), '\n');
-//            DEBUG_PRINT_LITE("Block D: %s | %s%c", data_D.to_string().c_str(), crc_D.to_string().c_str(), '\n');
+        for (auto &channel: channels) {
+            channel->decoder->_finish();
+            std::ostringstream frequency;
+            frequency << std::fixed << std::setprecision(1) << channel->frequency / 1e6 << " MHz";
+            const std::string output = channel->output.str();
+            if (!output.empty()) {
+                std::cout << "Station: " << frequency.str() << std::endl;
+                std::cout << output;
+            }
+            if (args->get_cache_stats()) {
+                std::cerr << "Station " << frequency.str() << ": ";
+                channel->sync.report(std::cerr);
+            }
         }
-        return blocks;
     }
 
     /**
-     * @brief Calculate the CRC for the given data and offset.
-     * If the order or rows is incorrect, the function will modify the blocks parameter in order to fix it.
-     *
-     * @param blocks The blocks to calculate the CRC for
-     */
-    bool _check_crc_and_fix_block_order(std::vector<Block> &blocks) {
-        for (auto &block: blocks) {
-            auto tmp_block = block.copy();
-            std::set<std::string> founded_offsets;
-            bool found = false;
-            for (const auto &[offset_key, offset_value]: OFFSET_WORDS) {
-                auto rows = std::vector<std::tuple<std::string, std::reference_wrapper<std::bitset<DATA_BITS>>, std::reference_wrapper<std::bitset<CRC_BITS>>>>{
-                        {"A", std::ref(tmp_block.data_A), std::ref(tmp_block.crc_A)},
-                        {"B", std::ref(tmp_block.data_B), std::ref(tmp_block.crc_B)},
-                        {"C", std::ref(tmp_block.data_C), std::ref(tmp_block.crc_C)},
-                        {"D", std::ref(tmp_block.data_D), std::ref(tmp_block.crc_D)}
-                };
-
-                for (const auto row: rows) {
-                    const std::string &row_key = std::get<0>(row);
-                    const std::bitset<DATA_BITS> &row_data = std::get<1>(row);
-                    const std::bitset<CRC_BITS> &row_crc = std::get<2>(row);
-
-                    const auto calculated_crc = calculate_crc(row_data, offset_value);
-                    if (calculated_crc == row_crc) {
-                        if (offset_key == "A") {
-                            DEBUG_PRINT_LITE("offset_key: %s, row_key: %s%c", offset_key.c_str(), row_key.c_str(), '\n');
-                            block.data_A = std::bitset<DATA_BITS>(row_data);
-                            block.crc_A = row_crc;
-                        } else if (offset_key == "B") {
-                            DEBUG_PRINT_LITE("offset_key: %s, row_key: %s%c", offset_key.c_str(), row_key.c_str(), '\n');
-                            block.data_B = row_data;
-                            block.crc_B = row_crc;
-                        } else if (offset_key == "C") {
-                            DEBUG_PRINT_LITE("offset_key: %s, row_key: %s%c", offset_key.c_str(), row_key.c_str(), '\n');
-                            block.data_C = row_data;
-                            block.crc_C = row_crc;
-                        } else if (offset_key == "D") {
-                            DEBUG_PRINT_LITE("offset_key: %s, row_key: %s%c", offset_key.c_str(), row_key.c_str(), '\n');
-                            block.data_D = row_data;
-                            block.crc_D = row_crc;
-                        } else {
-                            throw std::invalid_argument("Invalid offset key: " + offset_key);
-                        }
-                        founded_offsets.insert(offset_key);
-                        found = true;
-                        break;
-                    }
+     * @brief Channelizes the IQ recording, FM-demodulates the stations on the thread pool and syncs the
+     * demodulated bitstreams of all stations together, one lane of a bit-sliced block sync per station.
+     */
+    template<typename Word>
+    void _run_channels(IqReader &reader, const uint32_t sample_rate, const std::size_t channel_count, const std::size_t decimation,
+                       std::vector<std::unique_ptr<Channel>> &channels) {
+        std::vector<std::function<void()>> tasks;
+        for (auto &channel: channels) {
+            Channel *station = channel.get();
+            tasks.emplace_back([station]() {
+                station->mpx.resize(station->iq.size());
+                station->fm.process(station->iq.data(), station->mpx.data(), station->iq.size());
+                station->decoder->_demodulate(station->mpx.data(), station->mpx.size(), station->bits);
+                station->iq.clear();
+            });
+        }
+
+        // Stations are split into syncs of up to one lane word
+        const std::size_t lanes = BitsliceLanes<Word>::count;
+        std::vector<std::unique_ptr<BitslicedBlockSync<Word>>> syncs;
+        for (std::size_t first = 0; first < channels.size(); first += lanes) {
+            syncs.emplace_back(new BitslicedBlockSync<Word>(std::min(lanes, channels.size() - first)));
+        }
+
+        PolyphaseChannelizer channelizer(sample_rate, channel_count, decimation);
+        ThreadPool pool(args->get_jobs());
+        std::vector<float> i_in(IQ_CHUNK), q_in(IQ_CHUNK);
+        std::vector<const uint8_t *> streams;
+        for (std::size_t count = reader.read(i_in.data(), q_in.data(), i_in.size()); count > 0; count = reader.read(i_in.data(), q_in.data(), i_in.size())) {
+            channelizer.process(i_in.data(), q_in.data(), count, [&channels](const std::complex<float> *spectrum) {
+                for (auto &channel: channels) {
+                    channel->iq.push_back(spectrum[channel->bin]);
+                }
+            });
+            pool.run(tasks);
+
+            // All stations have the same bit rate, the streams are synced in lockstep up to the shortest one
+            for (std::size_t index = 0; index < syncs.size(); ++index) {
+                const std::size_t first = index * lanes;
+                std::size_t steps = SIZE_MAX;
+                streams.clear();
+                for (std::size_t lane = 0; lane < syncs[index]->lane_count(); ++lane) {
+                    streams.push_back(channels[first + lane]->bits.data());
+                    steps = std::min(steps, channels[first + lane]->bits.size());
+                }
+                syncs[index]->push_streams(streams, steps, [&channels, first](const std::size_t lane, const RawGroup &raw_group) {
+                    channels[first + lane]->decoder->_stream_group(raw_group);
+                });
+                for (std::size_t lane = 0; lane < syncs[index]->lane_count(); ++lane) {
+                    auto &bits = channels[first + lane]->bits;
+                    bits.erase(bits.begin(), bits.begin() + static_cast<std::ptrdiff_t>(steps));
+                    channels[first + lane]->sync = syncs[index]->counters(lane);
                 }
             }
+        }
+    }
 
-            if (!found) {
-                throw std::invalid_argument("CRC check failed - data is corrupted.");
+    /**
+     * @brief Decodes a compressed bitstream, groups are decompressed on the fly straight from the mapping.
+     * Decompressed groups are raw (checkwords included) and go through the same validation as -b.
+     */
+    void _decode_compressed(const std::string &path) {
+        const MappedFile file(path);
+        file.advise_sequential();
+        GroupDecompressor decompressor(file.bytes(), file.length());
+
+        RawGroup raw;
+        uint32_t group_index = 0;
+        for (auto item = decompressor.next(raw); item != GroupDecompressor::Item::END; item = decompressor.next(raw)) {
+            if (item != GroupDecompressor::Item::GROUP) {
+                continue;
             }
+            const uint64_t ingest = latency.enabled ? latency_now() : 0;
 
-            // Check that all founded offsets are unique
-            if (founded_offsets.size() != OFFSET_WORDS.size()) {
-                throw std::invalid_argument("Bad data - not all offsets are unique.");
-            }
+            //////////////////////////
+            /// Sync
+            //////////////////////////
+            const auto group = _to_block(raw, group_index);
+            const uint64_t synced = latency.enabled ? latency_now() : 0;
 
+            this->_process_group(group, group_index++, ingest, synced);
+        }
+    }
+
+    /**
+     * @brief Decodes groups of a capture container, only chunks the query may match are read.
+     * Groups in the container are already synchronized and validated.
+     */
+    void _decode_capture(const std::string &path) {
+        CaptureReader reader(path);
+
+        CaptureQuery query;
+        query.from = args->get_time_from();
+        query.to = args->get_time_to();
+        query.group_types = filter.get_group_types();
+        for (const auto program_id: filter.get_program_ids()) {
+            query.add_program_id(program_id);
         }
+
+        print_timestamps = true;
+        reader.for_each(query, [this](const CaptureRecord &record) {
+            const uint64_t ingest = latency.enabled ? latency_now() : 0;
+            if (!filter.accepts(record.words[0], record.words[1])) {
+                return;
+            }
+            if (capture_writer != nullptr) {
+                capture_writer->write(record.timestamp, record.words);
+            }
+            record_timestamp = record.timestamp;
+            this->_decode_group(record.words, ingest);
+        });
+
+        DEBUG_PRINT_LITE("Capture chunks scanned: %llu, skipped: %llu%c", static_cast<unsigned long long>(reader.chunks_scanned),
+                         static_cast<unsigned long long>(reader.chunks_skipped), '\n');
     }
 
 
@@ -330,175 +1805,603 @@ public:
     }
 
     ~ Program() {
+        delete capture_writer;
+        delete tmc_events;
+        delete tmc_locations;
+        delete block_sync;
+        delete mpx_demodulator;
         delete args;
     }
 
-    void decode_0A(const std::bitset<SIZE_0A> data) {
-        auto blocks = this->_get_blocks(data, BLOCKS_COUNT_IN_0A);
+    /**
+     * @brief Decodes one 0A group into the station.
+     *
+     * @param group Information words of blocks A, B, C, D
+     * @return true if the Program Service is complete and the record should be emitted
+     */
+    bool decode_0A(const uint16_t *group, Station &station) {
+        bool changed = false;
+        bool changed_common = false;
+
+        //////////////////////////
+        /// Decode Block B
+        //////////////////////////
+        uint16_t block_B = group[1];
+
+        // Traffic Program (TP)
+        changed_common |= _update(station.tp, TrafficProgramField::get(block_B));
+
+        // Program Type (PTY)
+        changed_common |= _update(station.pty, ProgramTypeField::get(block_B));
+
+        // Traffic Announcement (TA)
+        changed |= _update(station.ta, Group0A::TrafficAnnouncement::get(block_B));
+
+        // Music/Speech (MS)
+        changed |= _update(station.ms, Group0A::MusicSpeech::get(block_B));
+
+        // Decoder Identifier (DI)
+        changed |= _update(station.di, Group0A::DecoderIdentification::get(block_B));
 
-        DEBUG_PRINT_LITE("Block count: %d%c", blocks.size(), '\n');
-        DEBUG_PRINT_LITE("Data: %s%c", data.to_string().c_str(), '\n');
+        // PS segment address
+        const auto segment = static_cast<uint8_t>(Group0A::Segment::get(block_B));
 
         //////////////////////////
-        /// CRC
+        /// Decode Block C (Alternative Frequencies - AF)
         //////////////////////////
-        // Calculate the crc for each block and compare it with the received crc
-        // consider  that the block can be reorganized
-        this->_check_crc_and_fix_block_order(blocks);
+        uint16_t block_C = group[2];
+        const auto af_first = static_cast<uint8_t>(Group0A::AlternativeFrequency1::get(block_C));
+        const auto af_second = static_cast<uint8_t>(Group0A::AlternativeFrequency2::get(block_C));
+        changed |= station.af.push(af_first, af_second);
+        if (segment == 0 && !station.af.has_lists()) {
+            changed |= _update(station.af1, af_first);
+            changed |= _update(station.af2, af_second);
+        }
 
         //////////////////////////
-        /// Decode Block A (Program Identifier - PI)
+        /// Decode Block D (Program Service - PS)
         //////////////////////////
-        uint16_t program_id = static_cast<uint16_t>(blocks[0].data_A.to_ulong());
-        std::cout << "PI: " << program_id << std::endl;
+        uint16_t radio_data = group[3];
+        char *chars = station.program_service + segment * Group0A::chars_per_segment;
+        changed |= _update(chars[0], TextHighField::get(radio_data));
+        changed |= _update(chars[1], TextLowField::get(radio_data));
+        station.program_service_segments |= 1 << segment;
+
+        station.changed_0A |= changed || changed_common;
+        station.changed_2A |= changed_common;
+        if (!changed && !changed_common) {
+            group_cache.unchanged++;
+        }
+
+        // Full PS is obtained by concatenating all segments from Block D over time
+        return station.program_service_segments == (1 << Group0A::segments) - 1;
+    }
+
+    /**
+     * @brief Decodes one 2A group into the station.
+     *
+     * @param group Information words of blocks A, B, C, D
+     * @return true if the Radio Text is complete and the record should be emitted
+     */
+    bool decode_2A(const uint16_t *group, Station &station) {
+        bool changed = false;
+        bool changed_common = false;
 
         //////////////////////////
         /// Decode Block B
         //////////////////////////
-        uint16_t block_B = static_cast<uint16_t>(blocks[0].data_B.to_ulong());
-
-        // Group Type (GT) is 0A for this task
-        std::cout << "GT: 0A" << std::endl;
+        uint16_t block_B = group[1];
 
         // Traffic Program (TP)
-        uint8_t tp = (block_B >> 10) & 0x1;
-        std::cout << "TP: " << (tp == 1 ? "1" : "0") << std::endl;
+        changed_common |= _update(station.tp, TrafficProgramField::get(block_B));
 
         // Program Type (PTY)
-        uint8_t pty = (block_B >> 5) & 0x1F;
-        std::cout << "PTY: " << static_cast<int>(pty) << std::endl;
+        changed_common |= _update(station.pty, ProgramTypeField::get(block_B));
 
-        // Traffic Announcement (TA)
-        uint8_t ta = (block_B >> 4) & 0x1;
-        std::cout << "TA: " << (ta == 1 ? "Active" : "Inactive") << std::endl;
+        // Radio Text A/B Flag, a toggle means a new text - drop the partially received one
+        const auto ab_flag = static_cast<uint8_t>(Group2A::TextAB::get(block_B));
+        if (ab_flag != station.ab_flag && station.radio_text_segments != 0) {
+            std::memset(station.radio_text, ' ', sizeof(station.radio_text));
+            station.radio_text_segments = 0;
+        }
+        if (ab_flag != station.ab_flag) {
+            station.radio_text_received = 0;
+            station.radio_text_end = Group2A::segments;
+        }
+        changed |= _update(station.ab_flag, ab_flag);
 
-        // Music/Speech (MS)
-        uint8_t ms = (block_B >> 3) & 0x1;
-        std::cout << "MS: " << (ms == 1 ? "Music" : "Speech") << std::endl;
+        // RT segment address
+        const auto segment = static_cast<uint8_t>(Group2A::Segment::get(block_B));
 
-        // Decoder Identifier (DI)
-        uint8_t di = (block_B >> 2) & 0x1;
-        std::cout << "DI: " << static_cast<int>(di) << std::endl;
+        //////////////////////////
+        /// Decode Block C and D (Radio Text - RT)
+        //////////////////////////
+        uint16_t block_C_data = group[2];
+        uint16_t block_D_data = group[3];
+        char *chars = station.radio_text + segment * Group2A::chars_per_segment;
+        changed |= _update(chars[0], TextHighField::get(block_C_data));
+        changed |= _update(chars[1], TextLowField::get(block_C_data));
+        changed |= _update(chars[2], TextHighField::get(block_D_data));
+        changed |= _update(chars[3], TextLowField::get(block_D_data));
+        station.radio_text_segments |= 1 << segment;
+        station.radio_text_received |= 1 << segment;
+
+        // A text shorter than 64 characters ends with the marker, the following segments are not sent
+        if (std::memchr(chars, Group2A::end_of_text, Group2A::chars_per_segment) != nullptr) {
+            station.radio_text_end = static_cast<uint8_t>(segment + 1);
+        } else if (segment + 1 >= station.radio_text_end) {
+            // The marker moved on or was removed without a new A/B flag
+            station.radio_text_end = Group2A::segments;
+        }
+
+        station.changed_2A |= changed || changed_common;
+        station.changed_0A |= changed_common;
+        if (!changed && !changed_common) {
+            group_cache.unchanged++;
+        }
+
+        const auto needed = static_cast<uint16_t>((1u << station.radio_text_end) - 1);
+        return (station.radio_text_segments & needed) == needed;
+    }
+
+    /**
+     * @brief Decodes one 8A group (TMC) into the station.
+     *
+     * @param group Information words of blocks A, B, C, D
+     * @return true if a TMC message is complete and the record should be emitted
+     */
+    bool decode_8A(const uint16_t *group, Station &station) {
+        bool changed_common = false;
 
         //////////////////////////
-        /// Decode Block C (Alternative Frequencies - AF)
+        /// Decode Block B
         //////////////////////////
-        uint16_t block_C = static_cast<uint16_t>(blocks[0].data_C.to_ulong());
-        uint8_t af1 = (block_C >> 8) & 0xFF;
-        uint8_t af2 = block_C & 0xFF;
+        uint16_t block_B = group[1];
+
+        // Traffic Program (TP)
+        changed_common |= _update(station.tp, TrafficProgramField::get(block_B));
 
-        // Convert AF to MHz
-        double frequency1 = af1 / 10.0 + FREQUENCY_START;  // Assuming FREQUENCY_START is defined
-        double frequency2 = af2 / 10.0 + FREQUENCY_START;
-        // Print AF always with 1 decimal place
-        std::cout << "AF: " << std::fixed << std::setprecision(1) << frequency1 << ", " << frequency2 << std::endl;
+        // Program Type (PTY)
+        changed_common |= _update(station.pty, ProgramTypeField::get(block_B));
+        station.changed_0A |= changed_common;
+        station.changed_2A |= changed_common;
 
         //////////////////////////
-        /// Decode Block D (Program Service - PS)
+        /// Decode Block C and D (ALERT-C message)
+        //////////////////////////
+        TmcMessage message;
+        switch (station.tmc.push(block_B, group[2], group[3], message)) {
+            case TmcResult::TUNING:
+                tmc_tuning++;
+                return false;
+            case TmcResult::DROPPED:
+                tmc_dropped++;
+                return false;
+            case TmcResult::PARTIAL:
+                return false;
+            case TmcResult::MESSAGE:
+                break;
+        }
+        tmc_messages++;
+
+        // Messages are broadcast repeatedly, only a different one is emitted again
+        const bool changed = _update(station.tmc_message, message);
+        station.changed_8A |= changed || changed_common;
+        if (!changed && !changed_common) {
+            group_cache.unchanged++;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Group type index that carries the RT+ tags of the station, -1 if RT+ is not registered.
+     */
+    static int _rtplus_group(const Station &station) {
+        for (int index = 0; index < GROUP_TYPE_COUNT; ++index) {
+            if (station.oda_aid[index] == RTPLUS_AID) {
+                return index;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Decodes one 3A group (ODA registration) into the station.
+     *
+     * @param group Information words of blocks A, B, C, D
+     * @return Group type index of the application if the registration is new or changed, -1 otherwise
+     */
+    int decode_3A(const uint16_t *group, Station &station) {
+        bool changed_common = false;
+
+        //////////////////////////
+        /// Decode Block B
         //////////////////////////
-//        print_packet(data);
-        const auto buffer = new std::stringstream();
-        for (int i = 0; i < blocks.size(); ++i) {
-//            DEBUG_PRINT_LITE("i: %d\n", i);
-//            DEBUG_PRINT_LITE("Block D: %s\n", blocks[i].data_D.to_string().c_str());
+        uint16_t block_B = group[1];
 
-            // Extract data
-            uint16_t radio_data = static_cast<uint16_t>(blocks[i].data_D.to_ulong());
+        // Traffic Program (TP)
+        changed_common |= _update(station.tp, TrafficProgramField::get(block_B));
 
-            // Extract PS
-            uint8_t ps1 = (radio_data >> 8) & 0xFF;
-            uint8_t ps2 = radio_data & 0xFF;
+        // Program Type (PTY)
+        changed_common |= _update(station.pty, ProgramTypeField::get(block_B));
+        station.changed_0A |= changed_common;
+        station.changed_2A |= changed_common;
+
+        // Group type of the application, 0A means none and 15B a temporary fault
+        const int application_group = Group3A::ApplicationGroup::get(block_B);
+        if (application_group == 0 || application_group == GROUP_TYPE_COUNT - 1) {
+            return -1;
+        }
 
-            // Append to the buffer
-            *buffer << static_cast<char>(ps1) << static_cast<char>(ps2);
+        //////////////////////////
+        /// Decode Block C and D (application message and AID)
+        //////////////////////////
+        const auto aid = Group3A::ApplicationId::get(group[3]);
+        if (aid == RTPLUS_AID) {
+            station.rtplus.template_number = static_cast<uint8_t>(GroupRtPlus::TemplateNumber::get(group[2]));
         }
+        if (!_update(station.oda_aid[application_group], aid)) {
+            group_cache.unchanged++;
+            return -1;
+        }
+        return application_group;
+    }
+
+    /**
+     * @brief Decodes one RT+ group (the group type registered for RT+ by 3A) into the station.
+     *
+     * @param group Information words of blocks A, B, C, D
+     * @return true if the tags or the extracted items changed and the record should be emitted
+     */
+    bool decode_rtplus(const uint16_t *group, Station &station) {
+        bool changed_common = false;
+
+        //////////////////////////
+        /// Decode Block B
+        //////////////////////////
+        uint16_t block_B = group[1];
 
-        // Remove trailing spaces from start and end
-        std::string buffer_text = buffer->str();
-        auto buffer_trimmed = buffer_text.erase(buffer_text.find_last_not_of(" \n\r\t") + 1);
-        buffer_trimmed = buffer_trimmed.erase(0, buffer_text.find_first_not_of(" \n\r\t"));
+        // Traffic Program (TP)
+        changed_common |= _update(station.tp, TrafficProgramField::get(block_B));
 
-        std::cout << "PS: " << "\"" << buffer_trimmed << "\"" << std::endl;
+        // Program Type (PTY)
+        changed_common |= _update(station.pty, ProgramTypeField::get(block_B));
+        station.changed_0A |= changed_common;
+        station.changed_2A |= changed_common;
 
-        // Note: Full PS can be obtained by concatenating all segments from Block D over time
+        //////////////////////////
+        /// Decode Block B, C and D (tags)
+        //////////////////////////
+        bool changed = station.rtplus.push(block_B, group[2], group[3]);
+        changed |= station.rtplus.apply(station.radio_text, sizeof(station.radio_text),
+                                        station.radio_text_received, Group2A::chars_per_segment);
+        if (!changed) {
+            group_cache.unchanged++;
+        }
+        return changed;
     }
 
-    void decode_2A(const std::bitset<SIZE_2A> data) {
-        auto blocks = this->_get_blocks(data, BLOCKS_COUNT_IN_2A);
+    /**
+     * @brief Decodes one 14A group (EON) into the link between the station and the other network.
+     *
+     * @param group Information words of blocks A, B, C, D
+     * @return true if the Program Service of the other network is complete and the record should be emitted
+     */
+    bool decode_14A(const uint16_t *group, Station &station) {
+        bool changed = false;
+        bool changed_common = false;
+
+        //////////////////////////
+        /// Decode Block B
+        //////////////////////////
+        uint16_t block_B = group[1];
+
+        // Traffic Program (TP)
+        changed_common |= _update(station.tp, TrafficProgramField::get(block_B));
 
-        DEBUG_PRINT_LITE("Block count: %d%c", blocks.size(), '\n');
-        DEBUG_PRINT_LITE("Data: %s%c", data.to_string().c_str(), '\n');
+        // Program Type (PTY)
+        changed_common |= _update(station.pty, ProgramTypeField::get(block_B));
+        station.changed_0A |= changed_common;
+        station.changed_2A |= changed_common;
 
         //////////////////////////
-        /// CRC and Block Order Validation
+        /// Decode Block D (PI of the other network)
         //////////////////////////
-        // Validate and fix block order based on CRC and offsets
-        this->_check_crc_and_fix_block_order(blocks);
+        station.eon_other_pi = OtherProgramIdField::get(group[3]);
+        EonEntry &link = eon.at(station.program_id, station.eon_other_pi);
+        eon_groups++;
+
+        // Traffic Program of the other network (TP(ON))
+        changed |= _update(link.tp, Group14A::OtherTrafficProgram::get(block_B));
 
         //////////////////////////
-        /// Decode Block A (Program Identifier - PI)
+        /// Decode Block C, its content depends on the variant
         //////////////////////////
-        uint16_t program_id = static_cast<uint16_t>(blocks[0].data_A.to_ulong());
-        std::cout << "PI: " << program_id << std::endl;
+        uint16_t block_C = group[2];
+        const auto variant = static_cast<uint8_t>(Group14A::Variant::get(block_B));
+        const auto first = static_cast<uint8_t>(Group14A::TunedFrequency::get(block_C));
+        const auto second = static_cast<uint8_t>(Group14A::MappedFrequency::get(block_C));
+        if (variant < Group14A::ps_segments) {
+            char *chars = link.program_service + variant * Group14A::chars_per_segment;
+            changed |= _update(chars[0], TextHighField::get(block_C));
+            changed |= _update(chars[1], TextLowField::get(block_C));
+            link.program_service_segments |= 1 << variant;
+        } else if (variant == Group14A::variant_af) {
+            changed |= link.af.push(first, second);
+        } else if (variant >= Group14A::variant_mapped_first && variant < Group14A::variant_mapped_last
+                   && af_is_fm(first) && af_is_fm(second)) {
+            changed |= link.map(first, second);
+        } else if (variant == Group14A::variant_mapped_last && af_is_fm(first) && second >= 1 && second <= AF_CODE_MF_LAST) {
+            changed |= link.map(first, static_cast<uint16_t>(AF_CHANNEL_LFMF | second));
+        } else if (variant == Group14A::variant_linkage) {
+            changed |= _update(link.linkage, block_C) || !link.has_linkage;
+            link.has_linkage = true;
+        } else if (variant == Group14A::variant_pty_ta) {
+            changed |= _update(link.pty, Group14A::OtherProgramType::get(block_C)) || !link.has_pty;
+            changed |= _update(link.ta, Group14A::OtherTrafficAnnouncement::get(block_C));
+            link.has_pty = true;
+        } else if (variant == Group14A::variant_pin) {
+            changed |= _update(link.pin, block_C) || !link.has_pin;
+            link.has_pin = true;
+        }
+
+        link.changed |= changed || changed_common;
+        if (!changed && !changed_common) {
+            group_cache.unchanged++;
+        }
+
+        // Full PS of the other network is obtained by concatenating variants 0 - 3 over time
+        return link.program_service_segments == (1 << Group14A::ps_segments) - 1;
+    }
+
+    /**
+     * @brief Decodes one 14B group (EON TA switching) into the link between the station and the other network.
+     *
+     * @param group Information words of blocks A, B, C' (PI of the tuned network), D
+     * @return true if TA or TP of the other network changed and the record should be emitted
+     */
+    bool decode_14B(const uint16_t *group, Station &station) {
+        bool changed_common = false;
 
         //////////////////////////
         /// Decode Block B
         //////////////////////////
-        uint16_t block_B = static_cast<uint16_t>(blocks[0].data_B.to_ulong());
-
-        // Group Type (GT) is 2A for this task
-        std::cout << "GT: 2A" << std::endl;
+        uint16_t block_B = group[1];
 
         // Traffic Program (TP)
-        uint8_t tp = (block_B >> 10) & 0x1;
-        std::cout << "TP: " << (tp == 1 ? "1" : "0") << std::endl;
+        changed_common |= _update(station.tp, TrafficProgramField::get(block_B));
 
         // Program Type (PTY)
-        uint8_t pty = (block_B >> 5) & 0x1F;
-        std::cout << "PTY: " << static_cast<int>(pty) << std::endl;
-
-        // Radio Text A/B Flag
-        uint8_t ab_flag = (block_B >> 4) & 0x1;
-        std::cout << "A/B: " << (ab_flag == 1 ? "1" : "0") << std::endl;
+        changed_common |= _update(station.pty, ProgramTypeField::get(block_B));
+        station.changed_0A |= changed_common;
+        station.changed_2A |= changed_common;
 
         //////////////////////////
-        /// Decode Block C and D (Radio Text - RT)
+        /// Decode Block D (PI of the other network)
         //////////////////////////
-        std::stringstream radio_text_stream;
+        station.eon_other_pi = OtherProgramIdField::get(group[3]);
+        EonEntry &link = eon.at(station.program_id, station.eon_other_pi);
+        eon_groups++;
+
+        bool changed = _update(link.tp, Group14B::OtherTrafficProgram::get(block_B));
+        changed |= _update(link.ta, Group14B::OtherTrafficAnnouncement::get(block_B));
+        link.changed |= changed;
+        if (!changed) {
+            group_cache.unchanged++;
+        }
+        return changed;
+    }
+
+    /**
+     * @brief Restores the station state and the input position from the -sn snapshot, if it exists.
+     * Only a -f input (bits or packed) can be resumed from an offset.
+     */
+    void _restore_snapshot() {
+        snapshot_path = args->get_snapshot();
+        if (snapshot_path == nullptr) {
+            return;
+        }
+        snapshot_interval = args->get_snapshot_interval();
+        snapshot_countdown = snapshot_interval;
+        if (args->get_file() == nullptr || args->get_biphase() || args->get_capture_in() != nullptr || args->get_compressed() != nullptr
+            || args->get_iq_file() != nullptr || args->get_soft_bits() != nullptr || args->get_mpx_file() != nullptr) {
+            throw std::invalid_argument("Snapshots need a -f input (without -bp). Option: -sn, --snapshot");
+        }
+        snapshot_source = snapshot_input(args->get_file());
+        if (access(snapshot_path, F_OK) != 0) {
+            return; // First run
+        }
+
+        SnapshotReader snapshot(snapshot_path);
+        if (snapshot.packed() != args->get_packed()) {
+            throw std::invalid_argument("Snapshot was taken of a " + std::string(snapshot.packed() ? "packed" : "'0'/'1'") + " input: " + snapshot_path);
+        }
+
+        // A different or rotated input (same path, other file) is decoded from its start with empty state
+        const SnapshotInput &saved = snapshot.input();
+        const SnapshotInput current = snapshot_input(args->get_file(), saved.prefix_length);
+        if (!(current == saved) || current.size < saved.size || current.size < snapshot.input_offset()) {
+            std::cerr << "Snapshot ignored, it was taken of another input: " << snapshot_path << std::endl;
+            return;
+        }
+        snapshot_source = current;
+        input_offset = snapshot.input_offset();
+        input_groups = snapshot.groups();
+        for (std::size_t i = 0; i < snapshot.count(); ++i) {
+            const SnapshotStation record = snapshot.station(i);
+            auto &station = stations.at(record.program_id, [this](Station &evicted) {
+                _flush(evicted);
+            });
+            station.program_id = record.program_id;
+            station.tp = record.tp;
+            station.pty = record.pty;
+            station.ta = record.ta;
+            station.ms = record.ms;
+            station.di = record.di;
+            station.ab_flag = record.ab_flag;
+            station.af1 = record.af1;
+            station.af2 = record.af2;
+            station.af = record.af;
+            std::memcpy(station.program_service, record.program_service, sizeof(station.program_service));
+            station.program_service_segments = record.program_service_segments;
+            std::memcpy(station.radio_text, record.radio_text, sizeof(station.radio_text));
+            station.radio_text_segments = record.radio_text_segments;
+            station.radio_text_received = record.radio_text_received;
+            station.radio_text_end = record.radio_text_end;
+            station.changed_0A = record.changed_0A != 0;
+            station.changed_2A = record.changed_2A != 0;
+            std::memcpy(station.oda_aid, record.oda_aid, sizeof(station.oda_aid));
+        }
+        snapshot_restored = snapshot.count();
+    }
+
+    /**
+     * @brief Writes the station state with the input offset to the -sn snapshot.
+     * TMC reassembly, RT+ items and EON links are not part of it and are collected again.
+     */
+    void _write_snapshot() {
+        std::vector<SnapshotStation> records;
+        records.reserve(stations.size());
+        stations.for_each([&records](const Station &station) {
+            SnapshotStation record{};
+            record.program_id = station.program_id;
+            record.tp = station.tp;
+            record.pty = station.pty;
+            record.ta = station.ta;
+            record.ms = station.ms;
+            record.di = station.di;
+            record.ab_flag = station.ab_flag;
+            record.af1 = station.af1;
+            record.af2 = station.af2;
+            record.af = station.af;
+            std::memcpy(record.program_service, station.program_service, sizeof(record.program_service));
+            record.program_service_segments = station.program_service_segments;
+            std::memcpy(record.radio_text, station.radio_text, sizeof(record.radio_text));
+            record.radio_text_segments = station.radio_text_segments;
+            record.radio_text_received = station.radio_text_received;
+            record.radio_text_end = station.radio_text_end;
+            record.changed_0A = station.changed_0A;
+            record.changed_2A = station.changed_2A;
+            std::memcpy(record.oda_aid, station.oda_aid, sizeof(record.oda_aid));
+            records.push_back(record);
+        });
+        snapshot_write(snapshot_path, snapshot_source, args->get_packed(), input_offset, input_groups, records);
+        snapshots_written++;
+    }
+
+    /**
+     * @brief Called after each group of a -f input with the offset behind it, writes a snapshot every -sni groups.
+     */
+    void _snapshot_tick(const uint64_t offset) {
+        if (snapshot_path == nullptr) {
+            return;
+        }
+        input_offset = offset;
+        input_groups++;
+        if (--snapshot_countdown == 0) {
+            _write_snapshot();
+            snapshot_countdown = snapshot_interval;
+        }
+    }
 
-        DEBUG_PRINT_LITE("Blocks count: %d%c", blocks.size(), '\n');
-        for (int i = 0; i < blocks.size(); ++i) {
-            DEBUG_PRINT_LITE("Processing Block %d\n", i);
+    /**
+     * @brief Applies the options common to all inputs.
+     *
+     * @param with_capture Open the -co capture container (only one decoder may write it)
+     */
+    void _setup(const bool with_capture) {
+        latency.enabled = args->get_latency();
+        args->configure_filter(filter);
+
+        const std::size_t capacity = args->get_station_capacity();
+        if (capacity != stations.capacity()) {
+            stations.allocate(capacity);
+            eon.allocate(capacity * EON_LINKS_PER_STATION);
+        }
 
-            uint16_t block_C_data = static_cast<uint16_t>(blocks[i].data_C.to_ulong());
-            uint8_t char1 = (block_C_data >> 8) & 0xFF;
-            uint8_t char2 = block_C_data & 0xFF;
-            radio_text_stream << static_cast<char>(char1) << static_cast<char>(char2);
+        const char *capture_out = args->get_capture_out();
+        if (with_capture && capture_out != nullptr) {
+            capture_writer = new CaptureWriter(capture_out);
+            capture_start = capture_now();
+        }
+
+        const char *events = args->get_tmc_events();
+        if (events != nullptr) {
+            tmc_events = new TmcTable(events);
+        }
+        const char *locations = args->get_tmc_locations();
+        if (locations != nullptr) {
+            tmc_locations = new TmcTable(locations);
+        }
+    }
 
-            uint16_t block_D_data = static_cast<uint16_t>(blocks[i].data_D.to_ulong());
-            char1 = (block_D_data >> 8) & 0xFF;
-            char2 = block_D_data & 0xFF;
-            radio_text_stream << static_cast<char>(char1) << static_cast<char>(char2);
+    /**
+     * @brief Emits the records of the station that are not complete yet (end of input or eviction).
+     */
+    void _flush(Station &station) {
+        if (station.program_service_segments != 0 && station.changed_0A) {
+            _emit_0A(station);
+        }
+        if (station.radio_text_segments != 0 && station.changed_2A) {
+            _emit_2A(station);
         }
+    }
 
-        // Remove trailing spaces from start and end
-        std::string radio_text = radio_text_stream.str();
-        auto radio_text_trimmed = radio_text.erase(radio_text.find_last_not_of(" \n\r\t") + 1);
-        radio_text_trimmed = radio_text_trimmed.erase(0, radio_text.find_first_not_of(" \n\r\t"));
+    /**
+     * @brief Emits records that were not completed by the end of the input and closes the capture container.
+     */
+    void _finish() {
+        stations.for_each([this](Station &station) {
+            _flush(station);
+        });
 
-        // Output Radio Text
-        std::cout << "RT: " << "\"" << radio_text_trimmed << "\"" << std::endl;
+        if (capture_writer != nullptr) {
+            capture_writer->close();
+        }
     }
 
     void decode() {
+        const char *tmc_source = args->get_tmc_compile();
+        if (tmc_source != nullptr) {
+            tmc_compile_table(tmc_source, args->get_tmc_out());
+            return;
+        }
+
         DEBUG_PRINT_LITE("Decoding START%c", '\n');
-        if (_is_group_type_0A(args->get_data())) {
-            const auto converted_binary_data = _convert_to_bitset_size_0A(args->get_data());
-            decode_0A(converted_binary_data);
+        this->_setup(true);
+        this->_restore_snapshot();
+        if (latency.enabled) {
+            latency_install_report_signal();
+        }
+
+        const char *capture_in = args->get_capture_in();
+        const char *compressed = args->get_compressed();
+        const char *file = args->get_file();
+        const char *mpx_file = args->get_mpx_file();
+        const char *iq_file = args->get_iq_file();
+        const char *soft_file = args->get_soft_bits();
+        if (capture_in != nullptr) {
+            this->_decode_capture(capture_in);
+        } else if (compressed != nullptr) {
+            this->_decode_compressed(compressed);
+        } else if (iq_file != nullptr) {
+            this->_decode_iq(iq_file);
+        } else if (soft_file != nullptr) {
+            this->_decode_soft(soft_file);
+        } else if (mpx_file != nullptr) {
+            this->_decode_mpx(mpx_file);
+        } else if (file != nullptr) {
+            this->_decode_file(file, args->get_packed());
+        } else if (args->get_biphase()) {
+            const auto symbols = args->get_data();
+            this->_decode_binary_string(this->_biphase_decode(symbols.c_str(), symbols.size()));
+        } else {
+            this->_decode_binary_string(args->get_data());
         }
-        if (_is_group_type_2A(args->get_data())) {
-            const auto converted_binary_data = _convert_to_bitset_size_2A(args->get_data());
-            decode_2A(converted_binary_data);
+
+        this->_finish();
+        if (snapshot_path != nullptr) {
+            this->_write_snapshot();
         }
         DEBUG_PRINT_LITE("Decoding DONE%c", '\n');
     }
@@ -514,6 +2417,40 @@ public:
             std::cout << message << std::endl;
         }
 
+        // Dump the trace rings (no-op if -tr was not given)
+        trace_dump();
+
+        // Report group cache hit rate (only if -cs was given)
+        if (args->get_cache_stats()) {
+            group_cache.report(std::cerr);
+            std::cerr << "Group filter: " << filter.rejected << " groups rejected" << std::endl;
+            if (tmc_messages + tmc_tuning + tmc_dropped != 0) {
+                std::cerr << "TMC: " << tmc_messages << " messages, " << tmc_tuning << " tuning groups, "
+                          << tmc_dropped << " groups out of sequence" << std::endl;
+            }
+            std::cerr << "Stations: " << stations.size() << " of " << stations.capacity() << " slots, "
+                      << stations.evictions << " evicted" << std::endl;
+            if (snapshot_path != nullptr) {
+                std::cerr << "Snapshot: " << snapshot_restored << " stations restored, " << snapshots_written
+                          << " written, input offset " << input_offset << std::endl;
+            }
+            if (eon_groups != 0) {
+                std::cerr << "EON: " << eon.size() << " links of " << eon.capacity() << " slots from " << eon_groups
+                          << " groups, " << eon.evictions() << " evicted" << std::endl;
+            }
+            if (block_sync != nullptr) {
+                block_sync->report(std::cerr);
+            }
+            if (args->get_biphase()) {
+                std::cerr << "Biphase: " << biphase_invalid << " invalid symbol pairs" << std::endl;
+            }
+        }
+
+        // Report latency percentiles (only if -l was given)
+        if (latency.enabled) {
+            latency.report(std::cerr);
+        }
+
         delete this;
 
         // Cleanup and exit
@@ -536,6 +2473,8 @@ int main(int argc, char *argv[]) {
         program->exit_with_code(0);
     }
 
+    trace_set_dump_path(program->args->get_trace_file());
+
     try {
         program->decode();
     } catch (const std::invalid_argument &e) {
@@ -18,9 +18,35 @@
 #include <iomanip>
 #include <set>
 #include <cassert>
+#include <cctype>
 #include <functional> // For std::reference_wrapper
+#include <algorithm>
+#include <complex>
+#include <memory>
 
 #include "shared.hpp"
+#include "group_layout.hpp"
+#include "trace.hpp"
+#include "latency.hpp"
+#include "group_cache.hpp"
+#include "group_filter.hpp"
+#include "capture.hpp"
+#include "compress.hpp"
+#include "biphase.hpp"
+#include "wav.hpp"
+#include "mpx.hpp"
+#include "demod.hpp"
+#include "block_sync.hpp"
+#include "bitslice.hpp"
+#include "channelizer.hpp"
+#include "thread_pool.hpp"
+#include "tmc.hpp"
+#include "af.hpp"
+#include "charset.hpp"
+#include "eon.hpp"
+#include "rtplus.hpp"
+#include "station_table.hpp"
+#include "snapshot.hpp"
 
 
 #endif
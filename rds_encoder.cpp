@@ -17,36 +17,20 @@ private:
     int argc;
 
     /**
-     * @brief Returns the alternative frequencies as a vector of doubles.
-     * Caches the result so subsequent lookups are faster.
+     * @brief Returns the alternative frequencies as AF codes, parsed without floating point.
      */
-    std::vector<double> _get_alternative_frequencies() {
-        std::vector<double> frequencies;
+    std::vector<uint8_t> _get_alternative_frequencies() {
         const char *arg_value = this->_get_arg("-af", "--alternative-frequencies");
 
         if (arg_value == nullptr) {
             throw std::invalid_argument("Alternative frequencies are not specified. Option: -af, --alternative-frequencies. Group type: 0A");
         }
 
-        // NOTE: Separated this way, because we don't want to modify the original string
-        std::string input_str(arg_value);  // Create a copy of the input string
-        std::stringstream ss(input_str);   // Use stringstream for splitting
-        std::string token;
-
-        // Split the string by ',' without modifying the original string
-        while (std::getline(ss, token, ',')) {
-            try {
-                frequencies.push_back(std::stod(token));  // Convert and add to the vector
-            } catch (const std::invalid_argument &) {
-                throw std::invalid_argument("Invalid frequency value: " + token);
-            }
+        try {
+            return EncoderContent::to_frequencies(arg_value);
+        } catch (const std::invalid_argument &e) {
+            throw std::invalid_argument(std::string(e.what()) + ". Option: -af, --alternative-frequencies");
         }
-
-//        for (const auto &frequency: frequencies) {
-//            DEBUG_PRINT_LITE("%f\n", frequency);
-//        }
-
-        return frequencies;
     }
 
 
@@ -248,46 +232,22 @@ public:
     /**
      * Group type: 0A
      * -af
-     * Alternative Frequency 1st (8-bit unsigned integer).
+     * Alternative Frequencies, comma separated MHz (e.g. 104.5,98.0).
      *
-     * @return std::vector<double>
+     * @return AF codes (8-bit unsigned integers)
      *
      * @throws std::invalid_argument
      */
-    std::bitset<8> get_alternative_frequency_1() {
-        std::vector<double> frequencies = this->_get_alternative_frequencies();
-
-        // AF1: 8 - bit
-//        DEBUG_PRINT_LITE("Frequency: %f, size: %d\n", frequencies[0], frequencies.size());
-        auto alternative_frequency_1 = std::bitset<8>((short int) (frequencies[0] - FREQUENCY_START) * 10);
-        return alternative_frequency_1;
-    }
-
-    /**
-     * Group type: 0A
-     * -af
-     * Alternative Frequency 2nd (8-bit unsigned integer).
-     *
-     * @return std::vector<double>
-     *
-     * @throws std::invalid_argument
-     */
-    std::bitset<8> get_alternative_frequency_2() {
-        std::vector<double> frequencies = this->_get_alternative_frequencies();
-
-        // AF2: 8 - bit
-        const auto offset = (frequencies[1] - FREQUENCY_START) * 10;
-//        DEBUG_PRINT_LITE("Frequency 2: %f, size: %d, offset: %d\n", frequencies[1], frequencies.size(), offset);
-        auto alternative_frequency_2 = std::bitset<8>(offset);
-        return alternative_frequency_2;
+    std::vector<uint8_t> get_alternative_frequencies() {
+        return this->_get_alternative_frequencies();
     }
 
     /**
      * Group type: 0A
      * -ps
-     * Program Service (8-bit unsigned integer).
+     * Program Service, UTF-8 text of characters of the RDS character set.
      *
-     * @return const char *
+     * @return std::string 8 characters of G0 codes
      *
      * @throws std::invalid_argument
      */
@@ -297,21 +257,16 @@ public:
             throw std::invalid_argument("Program service is not specified. Option: -ps, --program-service. Group type: 0A");
         }
 
-        // length of the string is smaller that 8 add padding spaces to the end
-        if (strlen(program_service) < 8) {
-            std::string str(program_service);
-            str.resize(8, ' ');
-            return str;
-        }
-        return program_service;
+        // Shorter text is padded with spaces to 8 characters
+        return EncoderContent::to_program_service(program_service);
     }
 
     /**
      * Group type: 2A
      * -rt
-     * Radio Text
+     * Radio Text, UTF-8 text of characters of the RDS character set.
      *
-     * @return bool
+     * @return std::string G0 codes, whole segments: shorter text ends with Group2A::end_of_text and is padded with spaces
      *
      * @throws std::invalid_argument
      */
@@ -321,14 +276,8 @@ public:
             throw std::invalid_argument("Radio text is not specified. Option: -rt, --radio-text. Group type: 2A");
         }
 
-        // If radio text ength is smaller than 64 add padding spaces to the end
-        if (strlen(radio_text) < 64) {
-            std::string str(radio_text);
-            str.resize(64, ' ');
-            return str;
-        }
-
-        return radio_text;
+        // Longer text is cut to 64 characters
+        return EncoderContent::to_radio_text(radio_text);
     }
 
     /**
@@ -348,6 +297,169 @@ public:
         return this->_is_same(radio_text_ab_flag, "1");
     }
 
+    /**
+     * Common
+     * -tr
+     * Trace dump file, written on SIGUSR1, on error and at exit.
+     *
+     * @return const char * or nullptr if tracing to a file is not requested
+     */
+    const char *get_trace_file() {
+        return this->_get_arg("-tr", "--trace");
+    }
+
+    /**
+     * Common
+     * -co
+     * Capture container to write the generated groups to.
+     *
+     * @return const char * or nullptr if not requested
+     */
+    const char *get_capture_out() {
+        return this->_get_arg("-co", "--capture-out");
+    }
+
+    /**
+     * Common
+     * -bp
+     * Output differentially encoded biphase half-symbols (two per bit) instead of bits.
+     */
+    bool get_biphase() {
+        return this->_is_defined("-bp", "--biphase");
+    }
+
+    /**
+     * Common
+     * -mpx
+     * File to render the RDS subcarrier to (57 kHz DSB-SC with biphase symbols).
+     *
+     * @return const char * or nullptr if not requested
+     */
+    const char *get_mpx_file() {
+        return this->_get_arg("-mpx", "--mpx");
+    }
+
+    /**
+     * Common
+     * -sr
+     * Sample rate of the -mpx file in Hz.
+     *
+     * @throws std::invalid_argument
+     */
+    uint32_t get_sample_rate() {
+        const char *arg_value = this->_get_arg("-sr", "--sample-rate");
+        if (arg_value == nullptr) {
+            return MPX_SAMPLE_RATE_DEFAULT;
+        }
+        try {
+            const auto sample_rate = std::stoul(arg_value);
+            if (sample_rate < MPX_SAMPLE_RATE_MIN || sample_rate > MPX_SAMPLE_RATE_MAX) {
+                throw std::out_of_range(arg_value);
+            }
+            return static_cast<uint32_t>(sample_rate);
+        } catch (const std::logic_error &) {
+            throw std::invalid_argument("Invalid sample rate: " + std::string(arg_value) + ". Expected " + std::to_string(MPX_SAMPLE_RATE_MIN) + " - " + std::to_string(MPX_SAMPLE_RATE_MAX) + " Hz. Option: -sr, --sample-rate");
+        }
+    }
+
+    /**
+     * Common
+     * -raw
+     * Write the -mpx file as headerless 32-bit floats instead of WAV.
+     */
+    bool get_raw() {
+        return this->_is_defined("-raw", "--raw");
+    }
+
+    /**
+     * Common
+     * -rp
+     * How many times the group stream is repeated in the -mpx file.
+     *
+     * @throws std::invalid_argument
+     */
+    uint64_t get_repeat() {
+        const char *arg_value = this->_get_arg("-rp", "--repeat");
+        if (arg_value == nullptr) {
+            return 1;
+        }
+        try {
+            const auto repeat = std::stoull(arg_value);
+            if (repeat == 0) {
+                throw std::out_of_range(arg_value);
+            }
+            return repeat;
+        } catch (const std::logic_error &) {
+            throw std::invalid_argument("Invalid repeat count: " + std::string(arg_value) + ". Option: -rp, --repeat");
+        }
+    }
+
+    /**
+     * Common
+     * -ck
+     * Checkword kernel: auto (default, fastest the CPU supports), scalar (reference), table or clmul.
+     *
+     * @throws std::invalid_argument
+     */
+    CheckwordKernel get_checkword_kernel() {
+        const char *arg_value = this->_get_arg("-ck", "--checkword");
+        if (arg_value == nullptr || this->_is_same(arg_value, "auto")) {
+            return CheckwordKernel::AUTO;
+        }
+        for (const auto kernel: {CheckwordKernel::SCALAR, CheckwordKernel::TABLE, CheckwordKernel::CLMUL}) {
+            if (this->_is_same(arg_value, checkword_kernel_name(kernel))) {
+                return kernel;
+            }
+        }
+        throw std::invalid_argument("Invalid checkword kernel: " + std::string(arg_value) + ". Expected auto, scalar, table or clmul. Option: -ck, --checkword");
+    }
+
+    /**
+     * Common
+     * -live
+     * FIFO or Unix socket (created at the path) to read content updates from, one KEY=value per line
+     * (PS, RT, AF, PTY, TP, TA, MS). The encoder then sends 0A/2A groups continuously, paced at the RDS bit rate.
+     *
+     * @return const char * or nullptr if the live mode is not requested
+     */
+    const char *get_live() {
+        return this->_get_arg("-live", "--live");
+    }
+
+    /**
+     * Common
+     * -st
+     * Station file of the multi-station mode: [name] sections with PI=, OUT= and the KEY=value lines of -live.
+     * Every station gets its own 0A/2A carousel, repeated -rp times.
+     *
+     * @return const char * or nullptr if the multi-station mode is not requested
+     */
+    const char *get_stations() {
+        return this->_get_arg("-st", "--stations");
+    }
+
+    /**
+     * Common
+     * -j
+     * Worker threads of the multi-station mode, 0 (default) uses all hardware threads.
+     *
+     * @throws std::invalid_argument
+     */
+    std::size_t get_jobs() {
+        const char *arg_value = this->_get_arg("-j", "--jobs");
+        if (arg_value == nullptr) {
+            return 0;
+        }
+        try {
+            if (arg_value[0] < '0' || arg_value[0] > '9') {
+                throw std::out_of_range(arg_value);
+            }
+            return static_cast<std::size_t>(std::stoull(arg_value));
+        } catch (const std::logic_error &) {
+            throw std::invalid_argument("Invalid number of jobs: " + std::string(arg_value) + ". Option: -j, --jobs");
+        }
+    }
+
     void print_usage() {
         std::cout << "Usage: rds_encoder [options]" << std::endl;
         std::cout << "Options:" << std::endl;
@@ -361,6 +473,17 @@ public:
         std::cout << "  -m <music/speech>      Music/speech" << std::endl;
         std::cout << "  -T <traffic announcement> Traffic announcement" << std::endl;
         std::cout << "  -A <AB flag>           AB flag" << std::endl;
+        std::cout << "  -tr <file>             Trace dump file (written on SIGUSR1, error and exit)" << std::endl;
+        std::cout << "  -co <file>             Write the generated groups to a capture container" << std::endl;
+        std::cout << "  -bp                    Output biphase symbols (differential + biphase coding)" << std::endl;
+        std::cout << "  -mpx <file>            Render the RDS subcarrier (57 kHz) to a WAV file" << std::endl;
+        std::cout << "  -sr <rate>             Sample rate of the -mpx file in Hz (default 228000)" << std::endl;
+        std::cout << "  -raw                   Write the -mpx file as raw 32-bit floats" << std::endl;
+        std::cout << "  -rp <count>            Repeat the group stream in the -mpx file" << std::endl;
+        std::cout << "  -ck <kernel>           Checkword kernel: auto, scalar, table, clmul" << std::endl;
+        std::cout << "  -live <path>           Send 0A/2A continuously, read KEY=value updates from a FIFO or socket" << std::endl;
+        std::cout << "  -st <file>             Encode all stations of the station file (one file or tagged stdout lines each)" << std::endl;
+        std::cout << "  -j <count>             Worker threads of -st (default 0: all hardware threads)" << std::endl;
     }
 };
 
@@ -369,7 +492,159 @@ public:
  */
 class Program {
 private:
-    // TODO: Implement encoder logic here
+    /**
+     * @brief Checkwords of all blocks of a packet in one batch, four information words (A, B, C, D) per group.
+     */
+    static std::vector<uint16_t> _checkwords(const std::vector<uint16_t> &info) {
+        std::vector<uint16_t> offsets(info.size());
+        for (std::size_t i = 0; i < info.size(); ++i) {
+            offsets[i] = OFFSET_WORDS[i % BLOCK_PARTS_COUNT];
+        }
+        std::vector<uint16_t> checks(info.size());
+        checkwords(info.data(), offsets.data(), checks.data(), info.size());
+        return checks;
+    }
+
+    /**
+     * @brief Packet of consecutive groups from their information words, first group at the top.
+     */
+    template<std::size_t N>
+    static std::bitset<N> _assemble(const std::vector<uint16_t> &info) {
+        const auto checks = _checkwords(info);
+        const std::size_t groups = N / SIZE_GROUP;
+        std::bitset<N> packet(0);
+        for (std::size_t i = 0; i < info.size(); ++i) {
+            const std::size_t group = i / BLOCK_PARTS_COUNT;
+            const int block = static_cast<int>(i % BLOCK_PARTS_COUNT);
+            const uint32_t word = (static_cast<uint32_t>(info[i]) << CRC_BITS) | checks[i];
+            packet |= std::bitset<N>(word) << ((groups - 1 - group) * SIZE_GROUP + block_position(block));
+
+            // Trace the finished block: raw block word, no formatting on the hot path
+            TRACE_EVENT(TraceEventType::RAW_BLOCK, static_cast<uint8_t>(block), word, static_cast<uint32_t>(group));
+        }
+        return packet;
+    }
+
+    /**
+     * @brief Information words of the four 0A groups (whole PS).
+     */
+    static std::vector<uint16_t> _info_0A(const EncoderContent &content) {
+        // Decoder Identifier is always 0, the segment address is set per group
+        const uint16_t block_B = Group0A::BlockB::pack(Group0A::type, Group0A::version, content.traffic_program,
+                                                      content.program_type, content.traffic_announcement,
+                                                      content.music_speech, 0, 0);
+        DEBUG_PRINT_LITE("Block B %s\n", std::bitset<16>(block_B).to_string().c_str());
+
+        // Alternative Frequencies: two 8 - bit AF codes per group. Two frequencies are sent as a plain pair in
+        // the first group, other counts as a method A list (count code first) over the groups of the packet.
+        const auto &frequencies = content.frequencies;
+        uint16_t blocks_C[Group0A::segments] = {};
+        if (frequencies.size() == 2) {
+            blocks_C[0] = Group0A::BlockC::pack(frequencies[0], frequencies[1]);
+        } else {
+            std::vector<uint8_t> codes(1, static_cast<uint8_t>(AF_CODE_COUNT_BASE + frequencies.size()));
+            codes.insert(codes.end(), frequencies.begin(), frequencies.end());
+            codes.resize(Group0A::segments * 2, AF_CODE_FILLER);
+            for (int segment = 0; segment < Group0A::segments; ++segment) {
+                blocks_C[segment] = Group0A::BlockC::pack(codes[segment * 2], codes[segment * 2 + 1]);
+            }
+        }
+        DEBUG_PRINT_LITE("Alternative Frequency bits: %s\n", std::bitset<16>(blocks_C[0]).to_string().c_str());
+
+        std::vector<uint16_t> info;
+        for (int segment = 0; segment < Group0A::segments; ++segment) {
+            const char *chars = content.program_service.c_str() + segment * Group0A::chars_per_segment;
+            info.push_back(content.program_id);
+            info.push_back(Group0A::Segment::set(block_B, segment));
+            info.push_back(blocks_C[segment]);
+            info.push_back(Group0A::BlockD::pack(chars[0], chars[1]));
+        }
+        return info;
+    }
+
+    /**
+     * @brief Information words of the 2A groups up to the end of the Radio Text.
+     */
+    static std::vector<uint16_t> _info_2A(const EncoderContent &content) {
+        // The segment address is set per group
+        const uint16_t block_B = Group2A::BlockB::pack(Group2A::type, Group2A::version, content.traffic_program,
+                                                      content.program_type, content.ab_flag, 0);
+        DEBUG_PRINT_LITE("Block B: %s\n", std::bitset<16>(block_B).to_string().c_str());
+
+        // Only the segments up to the end of the text are sent
+        std::vector<uint16_t> info;
+        const auto segments = static_cast<int>(content.radio_text.size() / Group2A::chars_per_segment);
+        for (int segment = 0; segment < segments; ++segment) {
+            const char *chars = content.radio_text.c_str() + segment * Group2A::chars_per_segment;
+            info.push_back(content.program_id);
+            info.push_back(Group2A::Segment::set(block_B, segment));
+            info.push_back(Group2A::BlockC::pack(chars[0], chars[1]));
+            info.push_back(Group2A::BlockD::pack(chars[2], chars[3]));
+        }
+        return info;
+    }
+
+    /**
+     * @brief Information words of the carousel: 0A and 2A groups alternate, PS repeats while the Radio Text goes round.
+     */
+    static std::vector<uint16_t> _carousel_info(const EncoderContent &content) {
+        const auto info_0A = _info_0A(content);
+        const auto info_2A = _info_2A(content);
+        const std::size_t groups_0A = info_0A.size() / BLOCK_PARTS_COUNT;
+        const std::size_t groups_2A = info_2A.size() / BLOCK_PARTS_COUNT;
+
+        std::vector<uint16_t> info;
+        for (std::size_t i = 0; i < std::max(groups_0A, groups_2A); ++i) {
+            const auto group_0A = info_0A.begin() + static_cast<std::ptrdiff_t>(i % groups_0A * BLOCK_PARTS_COUNT);
+            const auto group_2A = info_2A.begin() + static_cast<std::ptrdiff_t>(i % groups_2A * BLOCK_PARTS_COUNT);
+            info.insert(info.end(), group_0A, group_0A + BLOCK_PARTS_COUNT);
+            info.insert(info.end(), group_2A, group_2A + BLOCK_PARTS_COUNT);
+        }
+        return info;
+    }
+
+    /**
+     * @brief Carousel of the live mode with its checkwords.
+     */
+    static LiveCarousel *_carousel(const EncoderContent &content) {
+        const auto info = _carousel_info(content);
+        const auto checks = _checkwords(info);
+        auto *carousel = new LiveCarousel();
+        for (std::size_t i = 0; i < info.size(); ++i) {
+            carousel->words.push_back((static_cast<uint32_t>(info[i]) << CRC_BITS) | checks[i]);
+        }
+        return carousel;
+    }
+
+    /**
+     * @brief Formats one group as a '0'/'1' line (with the line break), bits or biphase symbols.
+     *
+     * @param words BLOCK_PARTS_COUNT block words (26 bits)
+     * @param biphase_state State of the biphase coder of the stream, carried from group to group
+     * @param line At least SIZE_GROUP * 2 + 1 characters
+     * @return Characters written
+     */
+    static std::size_t _format_group(const uint32_t *words, const bool biphase, uint8_t &biphase_state, char *line) {
+        uint8_t bits[SIZE_GROUP / 8] = {}; // Packed, MSB first
+        uint8_t symbols[SIZE_GROUP * 2 / 8];
+        for (int bit = 0; bit < SIZE_GROUP; ++bit) {
+            const uint32_t value = words[bit / BLOCK_ROW_SIZE] >> (BLOCK_ROW_SIZE - 1 - bit % BLOCK_ROW_SIZE) & 1;
+            bits[bit / 8] = static_cast<uint8_t>(bits[bit / 8] | value << (7 - bit % 8));
+        }
+
+        const uint8_t *output = bits;
+        std::size_t length = SIZE_GROUP;
+        if (biphase) {
+            biphase_encode(bits, sizeof(bits), symbols, biphase_state);
+            output = symbols;
+            length = SIZE_GROUP * 2;
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            line[i] = static_cast<char>('0' + (output[i / 8] >> (7 - i % 8) & 1));
+        }
+        line[length] = '\n';
+        return length + 1;
+    }
 
 public:
     Args *args;
@@ -383,271 +658,317 @@ public:
 
     std::bitset<SIZE_0A> process_0A() {
         try {
+            EncoderContent content;
+
             ////////////////////////////
             /// BLOCK 1
             ////////////////////////////
             // PI Code: 16 - bit
-            const auto program_id = args->get_program_identifier();
-            const auto block_A = std::bitset<16>(program_id);
-            DEBUG_PRINT_LITE("Block A: %s\n", block_A.to_string().c_str());
-
-            // NOTE: Checkword + Offset A
-            const auto crc_A = calculate_crc(block_A, OFFSET_WORDS.at("A"));
-            DEBUG_PRINT_LITE("CRC A: %s\n", crc_A.to_string().c_str());
+            content.program_id = static_cast<uint16_t>(args->get_program_identifier());
+            DEBUG_PRINT_LITE("Block A: %s\n", std::bitset<16>(content.program_id).to_string().c_str());
 
             ////////////////////////////
             /// BLOCK 2
             ////////////////////////////
-            // Group Type: 4 - bit
-            std::bitset<4> group_type_bits(0);
-            DEBUG_PRINT_LITE("Program Type bits: %s\n", group_type_bits.to_string().c_str());
-
-            // ODA Type: 1 - bit
-            std::bitset<1> oda_type_bits(ODA_TYPE_A);
-            DEBUG_PRINT_LITE("ODA Type bits: %s\n", oda_type_bits.to_string().c_str());
-
             // Traffic Program: 1 - bit
-            const auto traffic_program = args->get_traffic_program();
-            std::bitset<1> traffic_program_bits(traffic_program);
-            DEBUG_PRINT_LITE("Traffic Program bits: %s\n", traffic_program_bits.to_string().c_str());
+            content.traffic_program = args->get_traffic_program();
+            DEBUG_PRINT_LITE("Traffic Program: %d\n", content.traffic_program);
 
             // Program Type: 5 - bit
-            const auto program_type = args->get_program_type();
-            std::bitset<5> program_type_bits(program_type);
-            DEBUG_PRINT_LITE("Program Type bits: %s\n", program_type_bits.to_string().c_str());
+            content.program_type = static_cast<uint8_t>(args->get_program_type());
+            DEBUG_PRINT_LITE("Program Type: %d\n", content.program_type);
 
             // Traffic Announcement: 1 - bit
-            const auto traffic_announcement = args->get_traffic_announcement();
-            std::bitset<1> traffic_announcement_bits(traffic_announcement);
-            DEBUG_PRINT_LITE("Traffic Announcement bits: %s\n", traffic_announcement_bits.to_string().c_str());
+            content.traffic_announcement = args->get_traffic_announcement();
+            DEBUG_PRINT_LITE("Traffic Announcement: %d\n", content.traffic_announcement);
 
             // Music/Speech: 1 - bit
-            const auto music_speech = args->get_music_speech();
-            std::bitset<1> music_speech_bits(music_speech);
-            DEBUG_PRINT_LITE("Music/Speech bits: %s\n", music_speech_bits.to_string().c_str());
-
-            // Decode Identifier: 1 - bit
-            std::bitset<1> decode_identifier_bits(0); // always 0
-            DEBUG_PRINT_LITE("Decode Identifier bits: %s\n", decode_identifier_bits.to_string().c_str());
-
-            auto block_B = std::bitset<16>(
-                    (group_type_bits.to_ulong() << 12) |
-                    (oda_type_bits.to_ulong() << 11) |
-                    (traffic_program_bits.to_ulong() << 10) |
-                    (program_type_bits.to_ulong() << 5) |
-                    (traffic_announcement_bits.to_ulong() << 4) |
-                    (music_speech_bits.to_ulong() << 3) |
-                    (decode_identifier_bits.to_ulong() << 2)
-            );
-            DEBUG_PRINT_LITE("Block B %s\n", block_B.to_string().c_str());
-
-            // NOTE: Word part: here, but calculated later
-
-            // NOTE: Checkword + Offset B
+            content.music_speech = args->get_music_speech();
+            DEBUG_PRINT_LITE("Music/Speech: %d\n", content.music_speech);
 
             ////////////////////////////
             /// BLOCK 3
             ////////////////////////////
-            // Alternative Frequency 1: 8 - bit
-            const auto alternative_frequency_1 = args->get_alternative_frequency_1();
-            DEBUG_PRINT_LITE("Alternative Frequency 1: %s\n", alternative_frequency_1.to_string().c_str());
-
-            // Alternative Frequency 2: 8 - bit
-            const auto alternative_frequency_2 = args->get_alternative_frequency_2();
-            DEBUG_PRINT_LITE("Alternative Frequency 2: %s\n", alternative_frequency_2.to_string().c_str());
-
-            // NOTE: Checkword + Offset C
-            auto block_C = std::bitset<16>((alternative_frequency_1.to_ulong() << 8) | alternative_frequency_2.to_ulong());
-            DEBUG_PRINT_LITE("Alternative Frequency bits: %s\n", block_C.to_string().c_str());
-            auto crc_C = calculate_crc(block_C, OFFSET_WORDS.at("C"));
-            DEBUG_PRINT_LITE("CRC 3: %s\n", crc_C.to_string().c_str());
+            content.frequencies = args->get_alternative_frequencies();
 
             ////////////////////////////
             /// BLOCK 4
             ////////////////////////////
-            const auto block_D = args->get_program_service();
-            DEBUG_PRINT_LITE("Program Service: '%s'\n", block_D.c_str());
-
-            // NOTE: Checkword + Offset D
-
+            content.program_service = args->get_program_service();
+            DEBUG_PRINT_LITE("Program Service: '%s'\n", content.program_service.c_str());
 
             ////////////////////////////
             /// Assemble the packet
             ////////////////////////////
-            std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE> all_blocks(0);
-            std::bitset<SIZE_0A> packet(0);
-            for (int i = 0; i < block_D.size(); i = i + 2) {
-//            for (int i = 0; i < 1; i = i + 2) {
-                // BLOCK A:
-                all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(block_A.to_ulong()) << (3 * 26 + 10);
-                all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(crc_A.to_ulong()) << (3 * 26);
-
-                // BLOCK B 1.:
-                // because i increasing by 2, but the segment number must increase by 1
-                const auto segment = std::bitset<2>(i / 2);
-                block_B &= std::bitset<16>(0b1111111111111100); // clear 1st two bits in data_B
-                block_B |= std::bitset<16>(segment.to_ulong());
-                all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(block_B.to_ulong()) << (2 * 26 + 10);
-                const auto crc_B = calculate_crc(block_B, OFFSET_WORDS.at("B"));
-//                DEBUG_PRINT_LITE("(i=%d)CRC B: %s\n", i, crc_B.to_string().c_str());
-                all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(crc_B.to_ulong()) << (2 * 26);
-
-                // BLOCK C:
-                if (i == 0) {
-                    all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(block_C.to_ulong()) << (1 * 26 + 10);
-                    all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(crc_C.to_ulong()) << (1 * 26);
-                } else {
-                    block_C = std::bitset<16>(0);
-                    crc_C = calculate_crc(block_C, OFFSET_WORDS.at("C"));
-                    all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(block_C.to_ulong()) << (1 * 26 + 10);
-                    all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(crc_C.to_ulong()) << (1 * 26);
-                }
-
-
-                // BLOCK D:
-                const auto chars = block_D.substr(i, 2);
-                uint16_t combined_value = (static_cast<uint16_t>(chars[0]) << 8) | static_cast<uint16_t>(chars[1]);
-                const auto crc_4 = calculate_crc(std::bitset<16>(combined_value), OFFSET_WORDS.at("D"));
-                all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(combined_value) << (0 * 26 + 10);
-                all_blocks |= std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE>(crc_4.to_ulong()) << (0 * 26);
-
-                const auto offset = BLOCKS_COUNT_IN_0A - (i / 2) - 1;
-                const auto total_offset = offset * BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE;
-//                DEBUG_PRINT_LITE("offset: %d, total_offset: %d\n", offset, total_offset);
-//                DEBUG_PRINT_LITE("all_blocks: %s\n", all_blocks.to_string().c_str());
-                const auto or_bits = std::bitset<packet.size()>(all_blocks.to_string()) << total_offset;
-//                DEBUG_PRINT_LITE("or_bits: %s\n", or_bits.to_string().c_str());
-                packet |= or_bits;
-
-//                DEBUG_PRINT_LITE("Packet: %d\n", i);
-                print_packet(all_blocks);
-                all_blocks.reset();
-            }
-            return packet;
+            return _assemble<SIZE_0A>(_info_0A(content));
         } catch (const std::exception &e) {
-            std::cerr << "Error processing Group 0A: " << e.what() << std::endl;
+            // Invalid options or text: no packet, main reports the error and exits non-zero
+            throw std::invalid_argument(std::string("Error processing Group 0A: ") + e.what());
         }
     }
 
-    std::bitset<SIZE_2A> process_2A() {
+    std::string process_2A() {
         try {
+            EncoderContent content;
+
             ////////////////////////////
             /// BLOCK 1
             ////////////////////////////
             // PI Code: 16 - bit
-            const auto program_id = args->get_program_identifier();
-            const auto block_A = std::bitset<16>(program_id);
-            DEBUG_PRINT_LITE("Block A: %s\n", block_A.to_string().c_str());
-
-            // NOTE: Checkword + Offset A
-            const auto crc_A = calculate_crc(block_A, OFFSET_WORDS.at("A"));
-            DEBUG_PRINT_LITE("CRC A: %s\n", crc_A.to_string().c_str());
+            content.program_id = static_cast<uint16_t>(args->get_program_identifier());
+            DEBUG_PRINT_LITE("Block A: %s\n", std::bitset<16>(content.program_id).to_string().c_str());
 
             ////////////////////////////
             /// BLOCK 2
             ////////////////////////////
-            // Group Type: 4 - bit
-            std::bitset<4> group_type_bits(2); // 2 for Group 2A
-            DEBUG_PRINT_LITE("Group Type bits: %s\n", group_type_bits.to_string().c_str());
-
-            // ODA Type: 1 - bit
-            std::bitset<1> oda_type_bits(ODA_TYPE_A);
-            DEBUG_PRINT_LITE("ODA Type bits: %s\n", oda_type_bits.to_string().c_str());
-
             // Traffic Program: 1 - bit
-            const auto traffic_program = args->get_traffic_program();
-            std::bitset<1> traffic_program_bits(traffic_program);
-            DEBUG_PRINT_LITE("Traffic Program bits: %s\n", traffic_program_bits.to_string().c_str());
+            content.traffic_program = args->get_traffic_program();
+            DEBUG_PRINT_LITE("Traffic Program: %d\n", content.traffic_program);
 
             // Program Type: 5 - bit
-            const auto program_type = args->get_program_type();
-            std::bitset<5> program_type_bits(program_type);
-            DEBUG_PRINT_LITE("Program Type bits: %s\n", program_type_bits.to_string().c_str());
+            content.program_type = static_cast<uint8_t>(args->get_program_type());
+            DEBUG_PRINT_LITE("Program Type: %d\n", content.program_type);
 
             // Radio Text A/B Flag: 1 - bit
-            const auto radio_text_ab_flag = args->get_radio_text_ab_flag();
-            std::bitset<1> radio_text_ab_bits(radio_text_ab_flag);
-            DEBUG_PRINT_LITE("Radio Text A/B Flag bits: %s\n", radio_text_ab_bits.to_string().c_str());
-
-            // NOTE: Word part: here, but calculated later
-
-            // NOTE: Checkword + Offset B
-
-            // Segment Address: 4 - bit
-            std::bitset<4> segment_address_bits(0); // Segment address starts from 0
-
-            // Forming Block B
-            auto block_B = std::bitset<16>(
-                    (group_type_bits.to_ulong() << 12) |
-                    (oda_type_bits.to_ulong() << 11) |
-                    (traffic_program_bits.to_ulong() << 10) |
-                    (program_type_bits.to_ulong() << 5) |
-                    (radio_text_ab_bits.to_ulong() << 4) |
-                    (segment_address_bits.to_ulong())
-            );
-            DEBUG_PRINT_LITE("Block B: %s\n", block_B.to_string().c_str());
+            content.ab_flag = args->get_radio_text_ab_flag();
+            DEBUG_PRINT_LITE("Radio Text A/B Flag: %d\n", content.ab_flag);
 
             ////////////////////////////
-            /// BLOCK 3
+            /// BLOCK 3 and 4
             ////////////////////////////
-            // Radio Text: 16 bits
-            const auto radio_text = args->get_radio_text();
-            DEBUG_PRINT_LITE("Radio Text: '%s'\n", radio_text.c_str());
+            // Radio Text: 4 characters per group
+            content.radio_text = args->get_radio_text();
+            DEBUG_PRINT_LITE("Radio Text: '%s'\n", content.radio_text.c_str());
 
             ////////////////////////////
             /// Assemble the packet
             ////////////////////////////
-            std::bitset<BLOCKS_COUNT_IN_0A * BLOCK_ROW_SIZE> all_blocks(0);
-            std::bitset<SIZE_2A> packet(0);
-            for (int i = 0; i < radio_text.size(); i += 4) { // Processing 4 characters per iteration
-//            for (int i = 0; i < 2; i += 4) { // Processing 4 characters per iteration
-                // BLOCK A:
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(block_A.to_ulong()) << (3 * 26 + 10);
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(crc_A.to_ulong()) << (3 * 26);
-
-                // BLOCK B:
-                segment_address_bits = std::bitset<4>(i / 4); // Update segment address
-                block_B &= std::bitset<16>(0b1111111111110000); // Clear segment address bits in data_B
-                block_B |= std::bitset<16>(segment_address_bits.to_ulong());
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(block_B.to_ulong()) << (2 * 26 + 10);
-                const auto crc_B = calculate_crc(block_B, OFFSET_WORDS.at("B"));
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(crc_B.to_ulong()) << (2 * 26);
-
-                // BLOCK C:
-                const auto chars_C = radio_text.substr(i, 2);
-                uint16_t combined_value_C = (static_cast<uint16_t>(chars_C[0]) << 8) | static_cast<uint16_t>(chars_C[1]);
-                const auto crc_C = calculate_crc(std::bitset<16>(combined_value_C), OFFSET_WORDS.at("C"));
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(combined_value_C) << (1 * 26 + 10);
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(crc_C.to_ulong()) << (1 * 26);
-
-                // BLOCK D:
-                const auto chars_D = radio_text.substr(i + 2, 2);
-                uint16_t combined_value_D = (static_cast<uint16_t>(chars_D[0]) << 8) | static_cast<uint16_t>(chars_D[1]);
-                const auto crc_D = calculate_crc(std::bitset<16>(combined_value_D), OFFSET_WORDS.at("D"));
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(combined_value_D) << (0 * 26 + 10);
-                all_blocks |= std::bitset<BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE>(crc_D.to_ulong()) << (0 * 26);
-                print_packet(all_blocks);
-
-//                DEBUG_PRINT_LITE("all_blocks: %s\n", all_blocks.to_string().c_str());
-
-                // Calculate total offset and combine blocks into the packet
-                const auto offset = BLOCKS_COUNT_IN_2A - (i / 4) - 1;
-                const auto total_offset = offset * BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE;
-                const auto or_bits = std::bitset<packet.size()>(all_blocks.to_string()) << total_offset;
-                packet |= or_bits;
-
-//                DEBUG_PRINT_LITE("Packet after iteration %d: %s\n", i, packet.to_string().c_str());
-
-//                // Reset all_blocks for next iteration
-                all_blocks.reset();
-            }
-            return packet;
+            const auto info = _info_2A(content);
+            return _assemble<SIZE_2A>(info).to_string().substr(0, info.size() / BLOCK_PARTS_COUNT * SIZE_GROUP);
         } catch (const std::exception &e) {
-            std::cerr << "Error processing Group 2A: " << e.what() << std::endl;
-            return {0};
+            // Invalid options or text: no packet, main reports the error and exits non-zero
+            throw std::invalid_argument(std::string("Error processing Group 2A: ") + e.what());
         }
     }
 
+    /**
+     * @brief Live mode: sends the 0A/2A carousel one group per line (bits or biphase symbols) at the RDS bit rate
+     * until SIGINT/SIGTERM. Updates from the channel are applied in a separate thread and published to the
+     * generator with a pointer swap, a new Radio Text toggles the A/B flag.
+     *
+     * @param path FIFO or Unix socket of the updates
+     */
+    void run_live(const char *path) {
+        EncoderContent content;
+        content.program_id = static_cast<uint16_t>(args->get_program_identifier());
+        content.program_type = static_cast<uint8_t>(args->get_program_type());
+        content.traffic_program = args->get_traffic_program();
+        content.traffic_announcement = args->get_traffic_announcement();
+        content.music_speech = args->get_music_speech();
+        content.ab_flag = args->get_radio_text_ab_flag();
+        content.frequencies = args->get_alternative_frequencies();
+        content.program_service = args->get_program_service();
+        content.radio_text = args->get_radio_text();
+
+        RcuPointer<LiveCarousel> carousel(_carousel(content));
+        LiveChannel channel(path);
+        live_install_stop_signal();
+
+        std::thread updater([&content, &carousel, &channel]() {
+            std::string line;
+            while (channel.read_line(line, live_stop_requested)) {
+                try {
+                    if (content.update(line)) {
+                        carousel.publish(_carousel(content), live_stop_requested);
+                    }
+                } catch (const std::invalid_argument &e) {
+                    std::cerr << "Live update rejected: " << e.what() << std::endl;
+                }
+            }
+        });
+
+        // Groups are due every SIZE_GROUP bit periods, the generator only copies prepared block words
+        const auto group_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(SIZE_GROUP / BIT_RATE));
+        const bool biphase = args->get_biphase();
+        auto due = std::chrono::steady_clock::now();
+        uint8_t biphase_state = 0;
+        char line[SIZE_GROUP * 2 + 1];
+        for (uint64_t position = 0; !live_stop_requested; ++position) {
+            const LiveCarousel *current = carousel.read();
+            const std::size_t length = _format_group(current->group(position % current->groups()), biphase, biphase_state, line);
+            carousel.quiescent_state();
+
+            std::cout.write(line, static_cast<std::streamsize>(length));
+            std::cout.flush();
+
+            due += group_period;
+            std::this_thread::sleep_until(due);
+        }
+        updater.join();
+    }
+
+    /**
+     * @brief Multi-station mode: encodes the carousel of every station of the station file, -rp times.
+     * Stations with OUT= get their own file (or pipe), the others share stdout as lines "name:groupbits",
+     * interleaved group by group.
+     *
+     * The work runs on a thread pool in three passes: the information words of each station, the checkwords
+     * of all stations as one batch cut into slices, and the formatting/writing of each stream.
+     *
+     * @param path Station file
+     */
+    void run_stations(const char *path) {
+        auto stations = stations_load(path);
+        const uint64_t repeat = args->get_repeat();
+        const bool biphase = args->get_biphase();
+        ThreadPool pool(args->get_jobs());
+        std::vector<std::function<void()>> tasks;
+
+        std::vector<std::vector<uint16_t>> carousels(stations.size());
+        for (std::size_t i = 0; i < stations.size(); ++i) {
+            tasks.emplace_back([&carousels, &stations, i]() {
+                carousels[i] = _carousel_info(stations[i].content);
+            });
+        }
+        pool.run(tasks);
+
+        // All carousels back to back, so the checkword kernel sees long batches instead of one per station
+        std::vector<std::size_t> first(stations.size() + 1, 0);
+        for (std::size_t i = 0; i < stations.size(); ++i) {
+            first[i + 1] = first[i] + carousels[i].size();
+        }
+        std::vector<uint16_t> info;
+        info.reserve(first.back());
+        for (const auto &carousel: carousels) {
+            info.insert(info.end(), carousel.begin(), carousel.end());
+        }
+        std::vector<uint16_t> offsets(info.size());
+        for (std::size_t i = 0; i < info.size(); ++i) {
+            offsets[i] = OFFSET_WORDS[i % BLOCK_PARTS_COUNT];
+        }
+        std::vector<uint16_t> checks(info.size());
+        tasks.clear();
+        for (std::size_t start = 0; start < info.size(); start += STATIONS_CHECKWORD_SLICE) {
+            const std::size_t count = std::min<std::size_t>(STATIONS_CHECKWORD_SLICE, info.size() - start);
+            tasks.emplace_back([&info, &offsets, &checks, start, count]() {
+                checkwords(info.data() + start, offsets.data() + start, checks.data() + start, count);
+            });
+        }
+        pool.run(tasks);
+
+        std::vector<std::string> tagged(stations.size());
+        tasks.clear();
+        for (std::size_t i = 0; i < stations.size(); ++i) {
+            tasks.emplace_back([&, i]() {
+                const std::size_t words = first[i + 1] - first[i];
+                const std::size_t group_count = words / BLOCK_PARTS_COUNT;
+                const std::size_t line_size = SIZE_GROUP * (biphase ? 2 : 1) + 1;
+                std::string stream;
+                stream.reserve(group_count * repeat * line_size);
+
+                uint8_t biphase_state = 0;
+                char line[SIZE_GROUP * 2 + 1];
+                for (uint64_t cycle = 0; cycle < repeat; ++cycle) {
+                    for (std::size_t group = 0; group < group_count; ++group) {
+                        uint32_t block_words[BLOCK_PARTS_COUNT];
+                        for (int block = 0; block < BLOCK_PARTS_COUNT; ++block) {
+                            const std::size_t index = first[i] + group * BLOCK_PARTS_COUNT + block;
+                            block_words[block] = (static_cast<uint32_t>(info[index]) << CRC_BITS) | checks[index];
+                        }
+                        stream.append(line, _format_group(block_words, biphase, biphase_state, line));
+                    }
+                }
+
+                if (stations[i].out.empty()) {
+                    tagged[i].swap(stream);
+                    return;
+                }
+                std::ofstream file(stations[i].out, std::ios::binary);
+                file.write(stream.data(), static_cast<std::streamsize>(stream.size()));
+                if (!file) {
+                    throw std::invalid_argument("Cannot write station output: " + stations[i].out);
+                }
+            });
+        }
+        pool.run(tasks);
+
+        // Stations without OUT= share stdout, one group of each station in turn
+        std::vector<std::size_t> positions(stations.size(), 0);
+        for (bool pending = true; pending;) {
+            pending = false;
+            for (std::size_t i = 0; i < stations.size(); ++i) {
+                if (positions[i] >= tagged[i].size()) {
+                    continue;
+                }
+                const std::size_t end = tagged[i].find('\n', positions[i]) + 1;
+                std::cout << stations[i].name << ':';
+                std::cout.write(tagged[i].data() + positions[i], static_cast<std::streamsize>(end - positions[i]));
+                positions[i] = end;
+                pending = true;
+            }
+        }
+        std::cout.flush();
+    }
+
+    /**
+     * @brief Writes the groups of the packet to the capture container given by -co (no-op without it).
+     * Groups are timestamped as if transmitted back to back from now on.
+     *
+     * @param packet The packet as '0'/'1' string
+     */
+    void write_capture(const std::string &packet) {
+        const char *path = args->get_capture_out();
+        if (path == nullptr) {
+            return;
+        }
+
+        CaptureWriter writer(path);
+        const uint64_t start = capture_now();
+        const std::size_t group_count = packet.size() / SIZE_GROUP;
+        for (std::size_t i = 0; i < group_count; ++i) {
+            uint16_t words[BLOCK_PARTS_COUNT];
+            for (int block = 0; block < BLOCK_PARTS_COUNT; ++block) {
+                words[block] = static_cast<uint16_t>(std::bitset<DATA_BITS>(packet, i * SIZE_GROUP + block * BLOCK_ROW_SIZE, DATA_BITS).to_ulong());
+            }
+            writer.write(start + static_cast<uint64_t>(i * SIZE_GROUP * 1000000.0 / BIT_RATE), words);
+        }
+        writer.close();
+    }
+
+    /**
+     * @brief Renders the packet as RDS subcarrier samples to the file given by -mpx (no-op without it).
+     *
+     * @param packet The packet as '0'/'1' string
+     */
+    void write_mpx(const std::string &packet) {
+        const char *path = args->get_mpx_file();
+        if (path == nullptr) {
+            return;
+        }
+
+        const uint32_t sample_rate = args->get_sample_rate();
+        const uint64_t repeat = args->get_repeat();
+        MpxSynthesizer synthesizer(sample_rate);
+        SampleWriter writer(path, sample_rate, args->get_raw());
+        for (uint64_t i = 0; i < repeat; ++i) {
+            for (const char bit: packet) {
+                synthesizer.push_bit(bit - '0', writer);
+            }
+        }
+        synthesizer.finish(writer);
+        writer.close();
+    }
+
+    /**
+     * @brief Formats the packet for stdout, as bits or as biphase half-symbols (-bp).
+     *
+     * @param packet The packet as '0'/'1' string
+     */
+    std::string format_output(const std::string &packet) {
+        return args->get_biphase() ? biphase_encode_ascii(packet) : packet;
+    }
+
     int exit_with_code(const int code, const std::string &message = "") {
         // Print message to stderr if code is not 0 and message is not empty
         if (code != 0 && !message.empty()) {
@@ -659,6 +980,9 @@ public:
             std::cout << message << std::endl;
         }
 
+        // Dump the trace rings (no-op if -tr was not given)
+        trace_dump();
+
         delete this;
 
         // Cleanup and exit
@@ -681,20 +1005,39 @@ int main(int argc, char *argv[]) {
         program->exit_with_code(0);
     }
 
+    trace_set_dump_path(program->args->get_trace_file());
+
     try {
+        checkword_select(program->args->get_checkword_kernel());
+
+        const char *stations = program->args->get_stations();
+        if (stations != nullptr) {
+            program->run_stations(stations);
+            program->exit_with_code(0);
+        }
+
+        const char *live = program->args->get_live();
+        if (live != nullptr) {
+            program->run_live(live);
+            program->exit_with_code(0);
+        }
+
         const auto group_type = program->args->get_group_type();
 
         if (group_type == Args::GroupType::A0) {
             DEBUG_PRINT_LITE("Processing Group %s\n", "0A");
             const auto packet = program->process_0A();
-            std::cout << packet.to_string() << std::endl;
+            std::cout << program->format_output(packet.to_string()) << std::endl;
+            program->write_capture(packet.to_string());
+            program->write_mpx(packet.to_string());
         }
 
         if (group_type == Args::GroupType::A2) {
             DEBUG_PRINT_LITE("Processing Group %s\n", "2A");
             const auto packet = program->process_2A();
-            print_packet(packet);
-            std::cout << packet.to_string() << std::endl;
+            std::cout << program->format_output(packet) << std::endl;
+            program->write_capture(packet);
+            program->write_mpx(packet);
         }
 //        const auto type = program->args->get_program_type();
 //        DEBUG_PRINT_LITE("Program Type: %d\n", type);
@@ -14,8 +14,24 @@
 #include <vector>
 #include <bitset>
 #include <sstream>
+#include <algorithm>
+#include <fstream>
+#include <functional>
 
 #include "rds_encoder.hpp"
 #include "shared.hpp"
+#include "checkword.hpp"
+#include "group_layout.hpp"
+#include "af.hpp"
+#include "charset.hpp"
+#include "content.hpp"
+#include "live.hpp"
+#include "stations.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include "capture.hpp"
+#include "biphase.hpp"
+#include "wav.hpp"
+#include "mpx.hpp"
 
 #endif
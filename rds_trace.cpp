@@ -0,0 +1,265 @@
+/**
+ * @file rds_trace.cpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Offline pretty-printer for binary trace dumps written by rds_encoder/rds_decoder (-tr option).
+ */
+#include "rds_trace.hpp"
+
+class Args {
+private:
+    std::map<std::string, char *> cached_args;
+    char **argv;
+    int argc;
+
+    /**
+     * @brief Returns the argument value corresponding to the given short or long option.
+     * Caches the result so subsequent lookups are faster.
+     */
+    char *_get_arg(const std::string &short_option, const std::string &long_option) {
+        // Check if the argument is already cached
+        std::string key = short_option.empty() ? long_option : short_option;
+        if (cached_args.find(key) != cached_args.end()) {
+            return cached_args[key]; // Return cached value
+        }
+
+        // If no cached value, search for it in argv
+        for (int i = 0; i < argc; i++) {
+            if (!short_option.empty() && strcmp(argv[i], short_option.c_str()) == 0) {
+                cached_args[short_option] = argv[i + 1]; // Cache the result
+                return argv[i + 1];
+            } else if (!long_option.empty() && strcmp(argv[i], long_option.c_str()) == 0) {
+                cached_args[long_option] = argv[i + 1]; // Cache the result
+                return argv[i + 1];
+            }
+        }
+
+        return nullptr; // If not found
+    }
+
+    /**
+     * @brief Checks if a given option is defined.
+     * Caches the result.
+     */
+    bool _is_defined(const std::string &short_option, const std::string &long_option) {
+        // Check if the result is already cached
+        std::string key = short_option.empty() ? long_option : short_option;
+        if (cached_args.find(key) != cached_args.end()) {
+            return true; // It was already defined
+        }
+
+        // Search argv for the option
+        for (int i = 0; i < argc; i++) {
+            if (!short_option.empty() && strcmp(argv[i], short_option.c_str()) == 0) {
+                cached_args[short_option] = argv[i]; // Cache it
+                return true;
+            } else if (!long_option.empty() && strcmp(argv[i], long_option.c_str()) == 0) {
+                cached_args[long_option] = argv[i]; // Cache it
+                return true;
+            }
+        }
+
+        return false; // Not defined
+    }
+
+public:
+    Args(char **argv, int argc) : argv(argv), argc(argc) {}
+
+    ~Args() = default;
+
+    bool get_help() {
+        return this->_is_defined("-h", "--help");
+    }
+
+    /**
+     * -f
+     * Trace dump to print.
+     *
+     * @throws std::invalid_argument
+     */
+    std::string get_file() {
+        const char *file = this->_get_arg("-f", "--file");
+        if (file == nullptr) {
+            throw std::invalid_argument("Trace file is not specified. Option: -f, --file");
+        }
+        return file;
+    }
+
+    void print_usage() {
+        std::cout << "Usage: rds_trace [options]" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  -h, --help\t\t\tShow this help message and exit" << std::endl;
+        std::cout << "  -f, --file <file>\t\tTrace dump written by rds_encoder/rds_decoder -tr" << std::endl;
+    }
+};
+
+/**
+ * @brief Class that holds global variables for the whole program
+ */
+class Program {
+private:
+    static const char *_event_name(const uint8_t type) {
+        switch (static_cast<TraceEventType>(type)) {
+            case TraceEventType::RAW_BLOCK:
+                return "RAW_BLOCK";
+            case TraceEventType::SYNDROME:
+                return "SYNDROME";
+            case TraceEventType::OFFSET:
+                return "OFFSET";
+            case TraceEventType::CORRECTION:
+                return "CORRECTION";
+            case TraceEventType::GROUP:
+                return "GROUP";
+            case TraceEventType::ERROR:
+                return "ERROR";
+        }
+        return "UNKNOWN";
+    }
+
+    static char _block_name(const uint8_t position) {
+        return position < BLOCK_PARTS_COUNT ? static_cast<char>('A' + position) : '?';
+    }
+
+    static std::string _error_name(const uint8_t code) {
+        switch (static_cast<TraceErrorCode>(code)) {
+            case TraceErrorCode::CRC:
+                return "CRC";
+            case TraceErrorCode::OFFSETS:
+                return "OFFSETS";
+            case TraceErrorCode::INPUT:
+                return "INPUT";
+        }
+        return "UNKNOWN(" + std::to_string(code) + ")";
+    }
+
+    /**
+     * @brief Formats a 26-bit block word as `data | check`.
+     */
+    static std::string _block_word(const uint32_t word) {
+        const auto data = std::bitset<DATA_BITS>(word >> CRC_BITS);
+        const auto crc = std::bitset<CRC_BITS>(word & ((1u << CRC_BITS) - 1));
+        return data.to_string() + " | " + crc.to_string();
+    }
+
+    void _print_event(const TraceEvent &event, const uint64_t start) {
+        std::cout << "  #" << std::setw(8) << std::left << event.sequence << std::right
+                  << " +" << std::setw(12) << std::fixed << std::setprecision(3) << (event.timestamp - start) / 1000.0 << "us  "
+                  << std::setw(10) << std::left << _event_name(event.type) << std::right << "  ";
+
+        switch (static_cast<TraceEventType>(event.type)) {
+            case TraceEventType::RAW_BLOCK:
+                std::cout << "group " << event.b << " block " << _block_name(event.tag) << ": " << _block_word(event.a);
+                break;
+            case TraceEventType::SYNDROME:
+                std::cout << "block " << _block_name(event.tag) << ": " << _block_word(event.a)
+                          << " syndrome " << std::bitset<CRC_BITS>(event.b).to_string();
+                break;
+            case TraceEventType::OFFSET:
+                std::cout << "group " << event.a << " row " << event.b << " has offset " << _block_name(event.tag);
+                break;
+            case TraceEventType::CORRECTION:
+                std::cout << "block " << _block_name(event.tag) << ": " << _block_word(event.a) << " -> " << _block_word(event.b);
+                break;
+            case TraceEventType::GROUP:
+                std::cout << "PI " << event.a << " GT " << (event.tag & 0xF) << ((event.tag & 0x10) ? 'B' : 'A')
+                          << " block B " << std::bitset<DATA_BITS>(event.b).to_string();
+                break;
+            case TraceEventType::ERROR:
+                std::cout << _error_name(event.tag) << " group " << event.a << " detail " << event.b;
+                break;
+            default:
+                std::cout << "tag " << static_cast<int>(event.tag) << " a " << event.a << " b " << event.b;
+                break;
+        }
+        std::cout << std::endl;
+    }
+
+public:
+    Args *args;
+
+    Program(Args *args) : args(args) {
+    }
+
+    ~Program() {
+        delete args;
+    }
+
+    void print_trace() {
+        const auto path = args->get_file();
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::invalid_argument("Cannot open trace file: " + path);
+        }
+
+        TraceFileHeader header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))
+            || std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0) {
+            throw std::invalid_argument("Not a trace file: " + path);
+        }
+        if (header.version != TRACE_VERSION || header.event_size != sizeof(TraceEvent)
+            || header.ring_size == 0 || (header.ring_size & (header.ring_size - 1)) != 0) {
+            throw std::invalid_argument("Unsupported trace format version " + std::to_string(header.version));
+        }
+
+        std::vector<TraceEvent> events(header.ring_size);
+        for (uint32_t thread = 0; thread < header.thread_count; ++thread) {
+            TraceRingHeader ring_header;
+            if (!file.read(reinterpret_cast<char *>(&ring_header), sizeof(ring_header))
+                || !file.read(reinterpret_cast<char *>(events.data()), events.size() * sizeof(TraceEvent))) {
+                throw std::invalid_argument("Truncated trace file: " + path);
+            }
+
+            // Only the last ring_size events survive, print them oldest first
+            const uint32_t count = ring_header.head < header.ring_size ? ring_header.head : header.ring_size;
+            const uint32_t first = ring_header.head - count;
+            std::cout << "Thread " << ring_header.thread_id << ": " << ring_header.head << " events recorded, "
+                      << count << " kept" << std::endl;
+            if (count == 0) {
+                continue;
+            }
+
+            const uint64_t start = events[first & (header.ring_size - 1)].timestamp;
+            for (uint32_t i = 0; i < count; ++i) {
+                _print_event(events[(first + i) & (header.ring_size - 1)], start);
+            }
+        }
+    }
+
+    int exit_with_code(const int code, const std::string &message = "") {
+        // Print message to stderr if code is not 0 and message is not empty
+        if (code != 0 && !message.empty()) {
+            std::cerr << message << std::endl;
+        }
+
+        // Print message to stdout if code is 0 and message is not empty
+        if (code == 0 && !message.empty()) {
+            std::cout << message << std::endl;
+        }
+
+        delete this;
+
+        // Cleanup and exit
+        exit(code);
+    }
+};
+
+int main(int argc, char *argv[]) {
+    auto *program = new Program(new Args(argv, argc));
+
+    if (program->args->get_help()) {
+        program->args->print_usage();
+        program->exit_with_code(0);
+    }
+
+    try {
+        program->print_trace();
+    } catch (const std::invalid_argument &e) {
+        program->exit_with_code(1, e.what());
+    } catch (const std::exception &e) {
+        program->exit_with_code(1, e.what());
+    }
+
+    // Exit with success code and no message
+    program->exit_with_code(0);
+}
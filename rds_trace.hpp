@@ -0,0 +1,21 @@
+/**
+ * @file rds_trace.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ */
+#ifndef RDS_TRACE_HPP
+#define RDS_TRACE_HPP
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+
+#include "shared.hpp"
+#include "trace.hpp"
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file rtplus.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * RadioText Plus (RT+): tags of the Radio Text that mark items (title, artist, ...) in it.
+ * The ODA is registered by a 3A group with the RT+ AID, its tags come in the announced group type.
+ * Items are cut from the Radio Text of the station once the segments a tag points to were received.
+ */
+#ifndef RTPLUS_HPP
+#define RTPLUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "group_layout.hpp"
+
+#define RTPLUS_AID (0x4BD7)
+#define RTPLUS_TAGS (2)
+#define RTPLUS_CONTENT_TYPES (64)
+#define RTPLUS_CONTENT_DUMMY (0) // Tag not used
+
+const char *const RTPLUS_CONTENT_TYPE_NAMES[RTPLUS_CONTENT_TYPES] = {
+        "DUMMY_CLASS", "ITEM.TITLE", "ITEM.ALBUM", "ITEM.TRACKNUMBER", "ITEM.ARTIST", "ITEM.COMPOSITION",
+        "ITEM.MOVEMENT", "ITEM.CONDUCTOR", "ITEM.COMPOSER", "ITEM.BAND", "ITEM.COMMENT", "ITEM.GENRE",
+        "INFO.NEWS", "INFO.NEWS.LOCAL", "INFO.STOCKMARKET", "INFO.SPORT", "INFO.LOTTERY", "INFO.HOROSCOPE",
+        "INFO.DAILY_DIVERSION", "INFO.HEALTH", "INFO.EVENT", "INFO.SCENE", "INFO.CINEMA", "INFO.STUPIDITY_MACHINE",
+        "INFO.DATE_TIME", "INFO.WEATHER", "INFO.TRAFFIC", "INFO.ALARM", "INFO.ADVERTISEMENT", "INFO.URL",
+        "INFO.OTHER", "STATIONNAME.SHORT", "STATIONNAME.LONG", "PROGRAMME.NOW", "PROGRAMME.NEXT", "PROGRAMME.PART",
+        "PROGRAMME.HOST", "PROGRAMME.EDITORIAL_STAFF", "PROGRAMME.FREQUENCY", "PROGRAMME.HOMEPAGE",
+        "PROGRAMME.SUBCHANNEL", "PHONE.HOTLINE", "PHONE.STUDIO", "PHONE.OTHER", "SMS.STUDIO", "SMS.OTHER",
+        "EMAIL.HOTLINE", "EMAIL.STUDIO", "EMAIL.OTHER", "MMS.OTHER", "CHAT", "CHAT.CENTRE", "VOTE.QUESTION",
+        "VOTE.CENTRE", "RFU.54", "RFU.55", "PRIVATE.56", "PRIVATE.57", "PRIVATE.58", "PLACE", "APPOINTMENT",
+        "IDENTIFIER", "PURCHASE", "GET_DATA"
+};
+
+/**
+ * @brief Item marked by a tag: `length` + 1 characters of the Radio Text from `start`.
+ */
+struct RtPlusTag {
+    uint8_t type = RTPLUS_CONTENT_DUMMY;
+    uint8_t start = 0;
+    uint8_t length = 0;
+
+    bool operator==(const RtPlusTag &other) const {
+        return type == other.type && start == other.start && length == other.length;
+    }
+};
+
+struct RtPlusItem {
+    uint8_t type;
+    std::string text;
+};
+
+/**
+ * @brief RT+ state of one station: the last tags and the items extracted with them.
+ */
+class RtPlus {
+private:
+    bool _set(const uint8_t type, const std::string &text) {
+        for (auto &item: items) {
+            if (item.type == type) {
+                const bool changed = item.text != text;
+                item.text = text;
+                return changed;
+            }
+        }
+        items.push_back(RtPlusItem{type, text});
+        return true;
+    }
+
+public:
+    uint8_t template_number = 0;
+    uint8_t toggle = 0;  // Flips when a new item starts
+    uint8_t running = 0; // An item is running
+    RtPlusTag tags[RTPLUS_TAGS];
+    std::vector<RtPlusItem> items;
+
+    /**
+     * @brief Takes the tags of one RT+ group.
+     *
+     * @return true if the tags or the item flags differ from the last group
+     */
+    bool push(const uint16_t block_B, const uint16_t block_C, const uint16_t block_D) {
+        RtPlusTag received[RTPLUS_TAGS];
+        received[0].type = static_cast<uint8_t>((GroupRtPlus::Type1High::get(block_B) << 3) | GroupRtPlus::Type1Low::get(block_C));
+        received[0].start = static_cast<uint8_t>(GroupRtPlus::Start1::get(block_C));
+        received[0].length = static_cast<uint8_t>(GroupRtPlus::Length1::get(block_C));
+        received[1].type = static_cast<uint8_t>((GroupRtPlus::Type2High::get(block_C) << 5) | GroupRtPlus::Type2Low::get(block_D));
+        received[1].start = static_cast<uint8_t>(GroupRtPlus::Start2::get(block_D));
+        received[1].length = static_cast<uint8_t>(GroupRtPlus::Length2::get(block_D));
+
+        bool changed = false;
+        const auto item_toggle = static_cast<uint8_t>(GroupRtPlus::ItemToggle::get(block_B));
+        if (item_toggle != toggle) {
+            // A new item, the items of the previous one no longer apply
+            items.clear();
+            toggle = item_toggle;
+            changed = true;
+        }
+        const auto item_running = static_cast<uint8_t>(GroupRtPlus::ItemRunning::get(block_B));
+        changed |= item_running != running;
+        running = item_running;
+        for (int i = 0; i < RTPLUS_TAGS; ++i) {
+            changed |= !(tags[i] == received[i]);
+            tags[i] = received[i];
+        }
+        return changed;
+    }
+
+    /**
+     * @brief Cuts the tagged items from the Radio Text, tags pointing to segments not yet received are skipped.
+     *
+     * @param text Radio Text of the station
+     * @param size Characters of the Radio Text
+     * @param received Segments of the current text received so far, one bit per segment
+     * @param chars_per_segment Characters carried by one segment
+     * @return true if an item was added or its text changed
+     */
+    bool apply(const char *text, const std::size_t size, const uint32_t received, const int chars_per_segment) {
+        bool changed = false;
+        for (const auto &tag: tags) {
+            const std::size_t end = static_cast<std::size_t>(tag.start) + tag.length;
+            if (tag.type == RTPLUS_CONTENT_DUMMY || end >= size) {
+                continue;
+            }
+            bool complete = true;
+            for (std::size_t segment = tag.start / chars_per_segment; segment <= end / chars_per_segment; ++segment) {
+                complete &= (received >> segment & 1) != 0;
+            }
+            if (!complete) {
+                continue;
+            }
+
+            std::string item(text + tag.start, end - tag.start + 1);
+            item.erase(item.find_last_not_of(' ') + 1);
+            item.erase(0, item.find_first_not_of(' '));
+            changed |= _set(tag.type, item);
+        }
+        return changed;
+    }
+};
+
+
+#endif
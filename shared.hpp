@@ -8,6 +8,8 @@
 
 #include <string>
 #include <bitset>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 
 #define ODA_TYPE_A (0)
@@ -18,10 +20,15 @@
 #define BLOCKS_COUNT_IN_0A (4)
 #define BLOCKS_COUNT_IN_2A (BLOCKS_COUNT_IN_0A * BLOCKS_COUNT_IN_0A)
 #define FREQUENCY_START (87.5)
+#define BIT_RATE (1187.5) // bit/s
+#define SIZE_GROUP (BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE)
 #define SIZE_0A (BLOCK_PARTS_COUNT * BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE)
 #define SIZE_2A (BLOCKS_COUNT_IN_2A * BLOCK_PARTS_COUNT * BLOCK_ROW_SIZE)
 #define CRC_POLYNOMIAL (0b10110111001)
-#define REGEX_TEXT "[a-zA-Z0-9 ]*"
+#define OFFSET_A (0)
+#define OFFSET_B (1)
+#define OFFSET_C (2)
+#define OFFSET_D (3)
 
 #define DEBUG (0)
 #define DEBUG_LITE (DEBUG)
@@ -40,6 +47,11 @@
  */
 template<std::size_t N>
 void print_packet(const std::bitset<N> &packet) {
+    // NOTE: Formatting is expensive, bail out before any work is done when debug output is off
+    if (!DEBUG_LITE) {
+        return;
+    }
+
     // Check size is multiple of 26
     if (packet.size() % BLOCK_ROW_SIZE != 0) {
         throw std::invalid_argument("Packet size must be a multiple of 26 bits.");
@@ -51,7 +63,7 @@ void print_packet(const std::bitset<N> &packet) {
     DEBUG_PRINT_LITE("Packet/Block: %s\n", foo.c_str());
 
     // Print whole packet as blocks
-    for (int i = 0; i < blocks; i++) {
+    for (std::size_t i = 0; i < blocks; i++) {
         std::bitset<BLOCK_ROW_SIZE> data_22 = std::bitset<data_22.size()>((packet << (i * BLOCK_ROW_SIZE)).to_string());
         const auto group = i % 4 == 0 ? 'A' : (i - 1) % 4 == 0 ? 'B' : (i - 2) % 4 == 0 ? 'C' : 'D';
         DEBUG_PRINT_LITE("(%d) Block %c: %s | %s\n", i / 4, group, data_22.to_string().substr(0, 16).c_str(), data_22.to_string().substr(16, 10).c_str());
@@ -59,39 +71,95 @@ void print_packet(const std::bitset<N> &packet) {
 }
 
 /**
- * @brief Optimized CRC-10 calculation function for a 16-bit message.
- *
- * @param message The 16-bit message to compute the CRC for.
- * @return std::bitset<10> The 10-bit CRC value.
+ * @brief Checkword of a 16-bit information word without offset (bit-serial modulo-2 division).
  */
-std::bitset<10> calculate_crc(const std::bitset<16> &message, std::bitset<10> offset) {
-    uint32_t data = message.to_ulong();  // Convert the 16-bit message to an unsigned integer
-    data <<= 10;  // Shift left by 10 bits to append 10 zero bits for CRC (message * x^10)
+constexpr uint16_t crc_checkword(const uint16_t message) {
+    uint32_t data = static_cast<uint32_t>(message) << CRC_BITS;  // message * x^10
+    for (int i = BLOCK_ROW_SIZE - 1; i >= CRC_BITS; --i) {
+        if (data & (1u << i)) {  // If the leading bit is set
+            data ^= static_cast<uint32_t>(CRC_POLYNOMIAL) << (i - CRC_BITS);
+        }
+    }
+    return static_cast<uint16_t>(data & ((1u << CRC_BITS) - 1));
+}
 
-    const int total_bits = 26;  // 16-bit message + 10-bit CRC space
+/**
+ * @brief Checkwords of the high and low byte of an information word, built at compile time.
+ * The checkword is linear in the message, so crc(word) = high[word >> 8] ^ low[word & 0xFF].
+ */
+struct CrcTable {
+    uint16_t high[256];
+    uint16_t low[256];
 
-    // Perform modulo-2 division (XOR) for CRC calculation
-    for (int i = total_bits - 1; i >= 10; --i) {
-        if (data & (1 << i)) {  // If the leading bit is set
-            data ^= (CRC_POLYNOMIAL << (i - 10));  // XOR with the generator polynomial shifted appropriately
+    constexpr CrcTable() : high(), low() {
+        for (uint32_t byte = 0; byte < 256; ++byte) {
+            high[byte] = crc_checkword(static_cast<uint16_t>(byte << 8));
+            low[byte] = crc_checkword(static_cast<uint16_t>(byte));
         }
     }
 
-    // The remainder is the CRC value
-    auto crc = std::bitset<10>(data & 0x3FF);  // Mask out the 10 bits for the CRC
+    constexpr uint16_t checkword(const uint16_t message) const {
+        return static_cast<uint16_t>(high[message >> 8] ^ low[message & 0xFF]);
+    }
+};
+
+constexpr CrcTable CRC_TABLE{};
+
+// x^10 mod g(x) = g(x) - x^10
+static_assert(CRC_TABLE.low[1] == (CRC_POLYNOMIAL ^ (1 << CRC_BITS)), "CRC table does not match the generator polynomial");
+
+/**
+ * @brief CRC-10 calculation function for a 16-bit message.
+ *
+ * @param message The 16-bit message to compute the CRC for.
+ * @return std::bitset<10> The 10-bit CRC value.
+ */
+std::bitset<10> calculate_crc(const std::bitset<16> &message, std::bitset<10> offset) {
+    auto crc = std::bitset<10>(CRC_TABLE.checkword(static_cast<uint16_t>(message.to_ulong())));
     crc ^= offset;  // XOR with the offset word
     return crc;
 }
 
 /**
- * @brief Offset words for each group.
+ * @brief Converts 8 ASCII '0'/'1' characters to a byte (first character is the MSB).
+ *
+ * @return false if any of the characters is not '0' or '1'
+ */
+bool ascii_to_byte(const char *text, uint8_t &byte) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t chars;
+    std::memcpy(&chars, text, sizeof(chars));
+    if ((chars & 0xFEFEFEFEFEFEFEFEULL) != 0x3030303030303030ULL) {
+        return false;
+    }
+    // Gathers bit 0 of every byte into the top byte, first byte ends up as the MSB
+    byte = static_cast<uint8_t>(((chars & 0x0101010101010101ULL) * 0x8040201008040201ULL) >> 56);
+    return true;
+#else
+    byte = 0;
+    for (int i = 0; i < 8; ++i) {
+        if (text[i] != '0' && text[i] != '1') {
+            return false;
+        }
+        byte = static_cast<uint8_t>((byte << 1) | (text[i] - '0'));
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief Offset words for each block, indexed by OFFSET_A..OFFSET_D.
  */
-const auto OFFSET_WORDS = std::map<std::string, std::bitset<CRC_BITS>>{
-        {"A", std::bitset<CRC_BITS>(0b0011111100)},
-        {"B", std::bitset<CRC_BITS>(0b0110011000)},
-        {"C", std::bitset<CRC_BITS>(0b0101101000)},
-        {"D", std::bitset<CRC_BITS>(0b0110110100)},
+constexpr uint16_t OFFSET_WORDS[BLOCK_PARTS_COUNT] = {
+        0b0011111100, // A
+        0b0110011000, // B
+        0b0101101000, // C
+        0b0110110100, // D
 };
 
+/**
+ * @brief Offset word of block C of version B groups (it carries the PI again).
+ */
+constexpr uint16_t OFFSET_WORD_C_PRIME = 0b1101010000;
 
 #endif
@@ -0,0 +1,212 @@
+/**
+ * @file snapshot.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Decoder state snapshot: the assembled state of all stations (flags, PS, RT, AF lists, ODA registrations)
+ * and the input offset it corresponds to, so a restarted decoder resumes where the previous one stopped
+ * instead of collecting everything again.
+ *
+ * Layout: SnapshotHeader, then `count` SnapshotStation records, native byte order. The header carries
+ * the record size, a snapshot of a build with a different record layout is rejected. It also identifies
+ * the input (device and inode, size and a hash of its first bytes when decoding started), so the offset
+ * is not applied to a different or rotated file.
+ * A snapshot is written to "<path>.tmp", synced and renamed over the path, so a crash while writing
+ * leaves the previous snapshot intact.
+ */
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "af.hpp"
+#include "group_filter.hpp"
+#include "group_layout.hpp"
+#include "mapped_file.hpp"
+
+#define SNAPSHOT_MAGIC "RDSSNAP"
+#define SNAPSHOT_VERSION (2)
+#define SNAPSHOT_DEFAULT_INTERVAL (10000) // Groups between two snapshots
+#define SNAPSHOT_PREFIX_BYTES (4096)      // Bytes of the input hashed to identify it
+#define SNAPSHOT_FNV_OFFSET (14695981039346656037ull)
+#define SNAPSHOT_FNV_PRIME (1099511628211ull)
+
+/**
+ * @brief Identity of the input file a snapshot belongs to.
+ */
+struct SnapshotInput {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;          // Size when decoding started, the file may only grow
+    uint64_t prefix_hash;   // FNV-1a of the first prefix_length bytes
+    uint32_t prefix_length;
+    uint32_t reserved;
+
+    bool operator==(const SnapshotInput &other) const {
+        return device == other.device && inode == other.inode && prefix_hash == other.prefix_hash
+               && prefix_length == other.prefix_length;
+    }
+};
+
+/**
+ * @brief Identifies the input file, hashing at most `prefix_length` of its first bytes.
+ *
+ * @throws std::invalid_argument if the file cannot be read
+ */
+SnapshotInput snapshot_input(const std::string &path, const std::size_t prefix_length = SNAPSHOT_PREFIX_BYTES) {
+    const MappedFile file(path);
+    struct stat info{};
+    if (stat(path.c_str(), &info) != 0) {
+        throw std::invalid_argument("Cannot stat file: " + path + " (" + std::strerror(errno) + ")");
+    }
+
+    SnapshotInput input{};
+    input.device = static_cast<uint64_t>(info.st_dev);
+    input.inode = static_cast<uint64_t>(info.st_ino);
+    input.size = file.length();
+    input.prefix_length = static_cast<uint32_t>(file.length() < prefix_length ? file.length() : prefix_length);
+    input.prefix_hash = SNAPSHOT_FNV_OFFSET;
+    for (std::size_t i = 0; i < input.prefix_length; ++i) {
+        input.prefix_hash = (input.prefix_hash ^ file.bytes()[i]) * SNAPSHOT_FNV_PRIME;
+    }
+    return input;
+}
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t packed;       // The input is packed (-pk), the offset is not valid for a '0'/'1' input and vice versa
+    uint32_t count;        // Station records
+    uint64_t input_offset; // Bytes of the input decoded into the snapshot
+    uint64_t groups;       // Groups of the input decoded into the snapshot
+    SnapshotInput input;
+};
+
+struct SnapshotStation {
+    uint16_t program_id;
+    uint8_t tp;
+    uint8_t pty;
+    uint8_t ta;
+    uint8_t ms;
+    uint8_t di;
+    uint8_t ab_flag;
+    uint8_t af1;
+    uint8_t af2;
+    uint8_t program_service_segments;
+    uint8_t radio_text_end;
+    uint8_t changed_0A;
+    uint8_t changed_2A;
+    uint16_t radio_text_segments;
+    uint16_t radio_text_received;
+    uint16_t oda_aid[GROUP_TYPE_COUNT];
+    char program_service[Group0A::segments * Group0A::chars_per_segment];
+    char radio_text[Group2A::segments * Group2A::chars_per_segment];
+    AfAssembler af;
+};
+
+static_assert(std::is_trivially_copyable<SnapshotStation>::value, "Snapshot records are copied as bytes");
+
+/**
+ * @brief Writes the snapshot atomically (temporary file, fsync, rename).
+ *
+ * @throws std::runtime_error
+ */
+void snapshot_write(const std::string &path, const SnapshotInput &input, const bool packed, const uint64_t input_offset,
+                    const uint64_t groups, const std::vector<SnapshotStation> &stations) {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.record_size = sizeof(SnapshotStation);
+    header.packed = packed;
+    header.input_offset = input_offset;
+    header.groups = groups;
+    header.input = input;
+    header.count = static_cast<uint32_t>(stations.size());
+
+    const std::string temporary = path + ".tmp";
+    const int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot write snapshot: " + temporary + " (" + std::strerror(errno) + ")");
+    }
+    const std::size_t records = stations.size() * sizeof(SnapshotStation);
+    const bool written = write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header))
+                         && (records == 0 || write(fd, stations.data(), records) == static_cast<ssize_t>(records))
+                         && fsync(fd) == 0;
+    const int error = errno;
+    close(fd);
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        const std::string reason = std::strerror(written ? errno : error);
+        unlink(temporary.c_str());
+        throw std::runtime_error("Cannot write snapshot: " + path + " (" + reason + ")");
+    }
+}
+
+/**
+ * @brief Snapshot file mapped for restoring.
+ */
+class SnapshotReader {
+private:
+    MappedFile file;
+    SnapshotHeader header{};
+
+public:
+    /**
+     * @throws std::invalid_argument if the file is not a snapshot of this build
+     */
+    explicit SnapshotReader(const std::string &path) : file(path) {
+        if (file.length() < sizeof(header)) {
+            throw std::invalid_argument("Invalid snapshot (too short): " + path);
+        }
+        std::memcpy(&header, file.bytes(), sizeof(header));
+        if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION
+            || header.record_size != sizeof(SnapshotStation)) {
+            throw std::invalid_argument("Invalid snapshot (not written by this version): " + path);
+        }
+        if (file.length() != sizeof(header) + static_cast<std::size_t>(header.count) * sizeof(SnapshotStation)) {
+            throw std::invalid_argument("Invalid snapshot (truncated): " + path);
+        }
+    }
+
+    bool packed() const {
+        return header.packed != 0;
+    }
+
+    const SnapshotInput &input() const {
+        return header.input;
+    }
+
+    uint64_t input_offset() const {
+        return header.input_offset;
+    }
+
+    uint64_t groups() const {
+        return header.groups;
+    }
+
+    std::size_t count() const {
+        return header.count;
+    }
+
+    /**
+     * @brief Copies record `index` out of the read-only mapping.
+     */
+    SnapshotStation station(const std::size_t index) const {
+        SnapshotStation record;
+        std::memcpy(&record, file.bytes() + sizeof(header) + index * sizeof(SnapshotStation), sizeof(record));
+        return record;
+    }
+};
+
+
+#endif
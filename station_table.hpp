@@ -0,0 +1,184 @@
+/**
+ * @file station_table.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Fixed-capacity table of per-station decoder state, keyed by PI (or by a wider integer key, e.g. the
+ * (tuned PI, other PI) pair of an EON link).
+ *
+ * All entries (with their PS/RT buffers) live in one slab allocated up front, so memory stays the same
+ * however many stations appear, e.g. when a drive test scans the band. When the slab is full, the least
+ * recently used station is evicted, approximated by the CLOCK algorithm: every lookup sets the referenced
+ * bit of its entry, the hand clears the bits it passes and evicts the first entry without one.
+ *
+ * The key index is a separate open-addressing array (linear probing, power-of-two size, at most half full),
+ * so a lookup probes a few small slots and touches the entry itself only once found.
+ */
+#ifndef STATION_TABLE_HPP
+#define STATION_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define STATION_TABLE_DEFAULT_CAPACITY (256)
+#define STATION_TABLE_MAX_CAPACITY (65536)  // One entry per PI
+#define STATION_TABLE_HASH_MULTIPLIER (2654435769u) // 2^32 / golden ratio
+#define STATION_TABLE_EMPTY (UINT32_MAX)
+
+template<typename T, typename Key = uint16_t>
+class StationTable {
+private:
+    struct IndexSlot {
+        Key key;
+        uint32_t entry; // STATION_TABLE_EMPTY if the slot is free
+    };
+
+    std::vector<T> entries;            // Slab, `capacity` entries
+    std::vector<Key> keys;             // Key of each used entry
+    std::vector<uint8_t> referenced;   // CLOCK bits
+    std::vector<IndexSlot> index;
+    std::size_t count = 0;
+    std::size_t hand = 0;
+    unsigned bits = 0;
+
+    std::size_t _home(const Key key) const {
+        return static_cast<std::size_t>(static_cast<uint32_t>(static_cast<uint32_t>(key) * STATION_TABLE_HASH_MULTIPLIER) >> (32 - bits));
+    }
+
+    /**
+     * @brief Index slot holding the key, or the free slot where it would be inserted.
+     */
+    std::size_t _probe(const Key key) const {
+        const std::size_t mask = index.size() - 1;
+        std::size_t slot = _home(key);
+        while (index[slot].entry != STATION_TABLE_EMPTY && index[slot].key != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    /**
+     * @brief Removes the key from the index, moving later slots of its probe run back (no tombstones).
+     */
+    void _unindex(const Key key) {
+        const std::size_t mask = index.size() - 1;
+        std::size_t hole = _probe(key);
+        index[hole].entry = STATION_TABLE_EMPTY;
+        for (std::size_t slot = (hole + 1) & mask; index[slot].entry != STATION_TABLE_EMPTY; slot = (slot + 1) & mask) {
+            // The slot may fill the hole only if its home is not between the hole and the slot (cyclically)
+            const std::size_t home = _home(index[slot].key);
+            if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+                index[hole] = index[slot];
+                index[slot].entry = STATION_TABLE_EMPTY;
+                hole = slot;
+            }
+        }
+    }
+
+    /**
+     * @brief Entry for a new station: a free one, or the victim of the CLOCK hand.
+     */
+    template<typename Evict>
+    std::size_t _claim(Evict &&evict) {
+        if (count < entries.size()) {
+            return count++;
+        }
+        while (referenced[hand]) {
+            referenced[hand] = 0;
+            hand = (hand + 1) % entries.size();
+        }
+        const std::size_t victim = hand;
+        hand = (hand + 1) % entries.size();
+
+        evict(entries[victim]);
+        _unindex(keys[victim]);
+        entries[victim] = T();
+        evictions++;
+        return victim;
+    }
+
+public:
+    uint64_t evictions = 0;
+
+    explicit StationTable(const std::size_t capacity = STATION_TABLE_DEFAULT_CAPACITY) {
+        allocate(capacity);
+    }
+
+    /**
+     * @brief Drops all entries and allocates the slab for `capacity` of them.
+     */
+    void allocate(const std::size_t capacity) {
+        entries.assign(capacity, T());
+        keys.assign(capacity, 0);
+        referenced.assign(capacity, 0);
+        bits = 1;
+        while ((static_cast<std::size_t>(1) << bits) < capacity * 2) {
+            bits++;
+        }
+        index.assign(static_cast<std::size_t>(1) << bits, IndexSlot{0, STATION_TABLE_EMPTY});
+        count = 0;
+        hand = 0;
+    }
+
+    /**
+     * @brief The station, created empty if it is not in the table. A full table evicts a station first.
+     *
+     * @param evict Called with the evicted station before it is reset
+     */
+    template<typename Evict>
+    T &at(const Key key, Evict &&evict) {
+        const std::size_t slot = _probe(key);
+        if (index[slot].entry != STATION_TABLE_EMPTY) {
+            referenced[index[slot].entry] = 1;
+            return entries[index[slot].entry];
+        }
+
+        const std::size_t entry = _claim(evict);
+        keys[entry] = key;
+        referenced[entry] = 1;
+        // The eviction may have moved index slots, probe again
+        index[_probe(key)] = IndexSlot{key, static_cast<uint32_t>(entry)};
+        return entries[entry];
+    }
+
+    /**
+     * @return The station, nullptr if it is not in the table
+     */
+    T *find(const Key key) {
+        const IndexSlot &slot = index[_probe(key)];
+        return slot.entry != STATION_TABLE_EMPTY ? &entries[slot.entry] : nullptr;
+    }
+
+    /**
+     * @brief Calls f for every entry in key order.
+     */
+    template<typename F>
+    void for_each(F &&f) {
+        std::vector<std::size_t> order(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [this](const std::size_t a, const std::size_t b) {
+            return keys[a] < keys[b];
+        });
+        for (const auto entry: order) {
+            f(entries[entry]);
+        }
+    }
+
+    /**
+     * @brief Number of stations.
+     */
+    std::size_t size() const {
+        return count;
+    }
+
+    std::size_t capacity() const {
+        return entries.size();
+    }
+};
+
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file stations.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Station file of the multi-station encoder: one section per station, the content as KEY=value lines
+ * (the keys of the live updates plus PI, AB and OUT).
+ *
+ *   # comment
+ *   [name]
+ *   PI=4660
+ *   PS=Radio 1
+ *   RT=Now playing
+ *   AF=104.5,98.0
+ *   OUT=radio1.bits   (optional, without it the groups go to the tagged stdout stream)
+ */
+#ifndef STATIONS_HPP
+#define STATIONS_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "content.hpp"
+
+#define STATIONS_CHECKWORD_SLICE (4096) // Information words per checkword task, a multiple of BLOCK_PARTS_COUNT
+
+struct StationConfig {
+    std::string name;
+    std::string out; // Empty: tagged stdout stream
+    bool has_program_id = false;
+    EncoderContent content;
+};
+
+/**
+ * @throws std::invalid_argument if the file cannot be read or a line is invalid
+ */
+std::vector<StationConfig> stations_load(const char *path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::invalid_argument("Cannot open station file: " + std::string(path));
+    }
+
+    std::vector<StationConfig> stations;
+    std::string line;
+    for (int number = 1; std::getline(file, line); ++number) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        const std::string where = std::string(path) + ":" + std::to_string(number) + ": ";
+        if (line[0] == '[' && line.back() == ']') {
+            StationConfig station;
+            station.name = line.substr(1, line.size() - 2);
+            station.content.radio_text = EncoderContent::to_radio_text("");
+            stations.push_back(station);
+            continue;
+        }
+        if (stations.empty()) {
+            throw std::invalid_argument(where + "Expected a [station] section first");
+        }
+
+        StationConfig &station = stations.back();
+        try {
+            const std::size_t separator = line.find('=');
+            const std::string key = line.substr(0, separator);
+            const std::string value = separator == std::string::npos ? "" : line.substr(separator + 1);
+            if (key == "PI") {
+                const unsigned long program_id = std::stoul(value);
+                if (program_id > UINT16_MAX) {
+                    throw std::out_of_range(value);
+                }
+                station.content.program_id = static_cast<uint16_t>(program_id);
+                station.has_program_id = true;
+            } else if (key == "AB") {
+                station.content.ab_flag = value == "1";
+            } else if (key == "OUT") {
+                station.out = value;
+            } else {
+                // Only AB= sets the A/B flag, a Radio Text in the file is not an update of a previous one
+                const bool ab_flag = station.content.ab_flag;
+                station.content.update(line);
+                station.content.ab_flag = ab_flag;
+            }
+        } catch (const std::logic_error &e) {
+            throw std::invalid_argument(where + e.what());
+        }
+    }
+
+    for (const auto &station: stations) {
+        if (!station.has_program_id) {
+            throw std::invalid_argument(std::string(path) + ": Station [" + station.name + "] has no PI");
+        }
+    }
+    if (stations.empty()) {
+        throw std::invalid_argument(std::string(path) + ": No stations");
+    }
+    return stations;
+}
+
+
+#endif
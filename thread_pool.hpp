@@ -0,0 +1,112 @@
+/**
+ * @file thread_pool.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ */
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads running batches of independent tasks.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::vector<std::function<void()>> *tasks = nullptr;
+    std::size_t next_task = 0;
+    std::size_t running = 0;
+    uint64_t batch = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void _work() {
+        uint64_t seen_batch = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            work_ready.wait(lock, [this, seen_batch] { return stopping || batch != seen_batch; });
+            if (stopping) {
+                return;
+            }
+            seen_batch = batch;
+
+            while (next_task < tasks->size()) {
+                auto &task = (*tasks)[next_task++];
+                running++;
+                lock.unlock();
+                try {
+                    task();
+                } catch (...) {
+                    lock.lock();
+                    error = error ? error : std::current_exception();
+                    lock.unlock();
+                }
+                lock.lock();
+                running--;
+            }
+            if (running == 0) {
+                work_done.notify_all();
+            }
+        }
+    }
+
+public:
+    /**
+     * @param threads Worker count, 0 = one per hardware thread
+     */
+    explicit ThreadPool(std::size_t threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back(&ThreadPool::_work, this);
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_ready.notify_all();
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Runs all tasks on the workers and waits for them. The first exception thrown by a task is rethrown.
+     */
+    void run(std::vector<std::function<void()>> &batch_tasks) {
+        std::unique_lock<std::mutex> lock(mutex);
+        tasks = &batch_tasks;
+        next_task = 0;
+        batch++;
+        work_ready.notify_all();
+        work_done.wait(lock, [this] { return next_task >= tasks->size() && running == 0; });
+
+        if (error) {
+            auto rethrown = error;
+            error = nullptr;
+            std::rethrow_exception(rethrown);
+        }
+    }
+};
+
+
+#endif
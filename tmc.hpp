@@ -0,0 +1,331 @@
+/**
+ * @file tmc.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Traffic Message Channel (ALERT-C, group 8A): message reassembly and code tables.
+ *
+ * Table layout (compiled once from a `code;text` CSV, then only mapped):
+ *   TmcTableHeader
+ *   TmcTableEntry[count]      sorted by code
+ *   string pool               NUL-terminated texts, entries point into it
+ *
+ * A lookup is a binary search over the mapped entries, opening a table costs one mmap.
+ */
+#ifndef TMC_HPP
+#define TMC_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "group_layout.hpp"
+#include "mapped_file.hpp"
+
+#define TMC_TABLE_MAGIC "RDSTMCT1"
+#define TMC_CONTINUITY_INDICES (8)
+#define TMC_SUBSEQUENT_GROUPS_MAX (4)  // Second group + up to 3 more (2-bit sequence index)
+#define TMC_FREE_FORMAT_BITS (28)      // Per subsequent group: 12 bits of block C + block D
+#define TMC_LABEL_BITS (4)
+#define TMC_LABEL_SEPARATOR (14)
+#define TMC_LABEL_ADDITIONAL_EVENT (9)
+#define TMC_LABEL_DURATION (0)
+
+struct TmcTableHeader {
+    char magic[8];
+    uint32_t count;   // Entries
+    uint32_t strings; // Bytes of the string pool
+};
+
+struct TmcTableEntry {
+    uint32_t code;
+    uint32_t text; // Offset of the text in the string pool
+};
+
+static_assert(sizeof(TmcTableHeader) == 16, "TmcTableHeader is part of the file format");
+static_assert(sizeof(TmcTableEntry) == 8, "TmcTableEntry is part of the file format");
+
+/**
+ * @brief Compiles a `code;text` CSV (event list or location table) into a sorted binary table.
+ * Lines whose first column is not a number (headers, comments) are skipped, further columns are ignored.
+ *
+ * @throws std::invalid_argument if a file cannot be opened or a code is listed twice
+ */
+void tmc_compile_table(const std::string &csv_path, const std::string &table_path) {
+    std::ifstream csv(csv_path);
+    if (!csv) {
+        throw std::invalid_argument("Cannot open TMC table source: " + csv_path);
+    }
+
+    std::vector<std::pair<uint32_t, std::string>> rows;
+    std::string line;
+    while (std::getline(csv, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        const auto separator = line.find(';');
+        if (separator == 0 || separator == std::string::npos || separator > 9
+            || line.find_first_not_of("0123456789") != separator) {
+            continue;
+        }
+        const auto end = line.find(';', separator + 1);
+        rows.emplace_back(static_cast<uint32_t>(std::stoul(line.substr(0, separator))),
+                          line.substr(separator + 1, end == std::string::npos ? std::string::npos : end - separator - 1));
+    }
+    std::stable_sort(rows.begin(), rows.end(), [](const std::pair<uint32_t, std::string> &a, const std::pair<uint32_t, std::string> &b) {
+        return a.first < b.first;
+    });
+
+    std::vector<TmcTableEntry> entries;
+    std::string strings;
+    for (const auto &row: rows) {
+        if (!entries.empty() && entries.back().code == row.first) {
+            throw std::invalid_argument("Duplicate code " + std::to_string(row.first) + " in TMC table source: " + csv_path);
+        }
+        entries.push_back(TmcTableEntry{row.first, static_cast<uint32_t>(strings.size())});
+        strings.append(row.second);
+        strings.push_back('\0');
+    }
+
+    TmcTableHeader header;
+    std::memcpy(header.magic, TMC_TABLE_MAGIC, sizeof(header.magic));
+    header.count = static_cast<uint32_t>(entries.size());
+    header.strings = static_cast<uint32_t>(strings.size());
+
+    std::ofstream table(table_path, std::ios::binary | std::ios::trunc);
+    if (!table) {
+        throw std::invalid_argument("Cannot create TMC table: " + table_path);
+    }
+    table.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    table.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(TmcTableEntry)));
+    table.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+    if (!table) {
+        throw std::invalid_argument("Cannot write TMC table: " + table_path);
+    }
+}
+
+/**
+ * @brief Read-only view of a compiled table, code -> text.
+ */
+class TmcTable {
+private:
+    MappedFile file;
+    const TmcTableEntry *entries = nullptr;
+    uint32_t count = 0;
+    const char *strings = nullptr;
+    uint32_t strings_size = 0;
+
+public:
+    /**
+     * @throws std::invalid_argument if the file is not a compiled table
+     */
+    explicit TmcTable(const std::string &path) : file(path) {
+        TmcTableHeader header;
+        if (file.length() < sizeof(header)) {
+            throw std::invalid_argument("Not a TMC table: " + path);
+        }
+        std::memcpy(&header, file.bytes(), sizeof(header));
+        const uint64_t expected = sizeof(header) + static_cast<uint64_t>(header.count) * sizeof(TmcTableEntry) + header.strings;
+        if (std::memcmp(header.magic, TMC_TABLE_MAGIC, sizeof(header.magic)) != 0 || expected != file.length()
+            || (header.strings > 0 && file.bytes()[file.length() - 1] != '\0')) {
+            throw std::invalid_argument("Not a TMC table: " + path);
+        }
+        file.advise_random();
+        count = header.count;
+        entries = reinterpret_cast<const TmcTableEntry *>(file.bytes() + sizeof(header));
+        strings = reinterpret_cast<const char *>(entries + count);
+        strings_size = header.strings;
+    }
+
+    /**
+     * @return Text of the code, nullptr if the table does not list it
+     */
+    const char *lookup(const uint32_t code) const {
+        const auto found = std::lower_bound(entries, entries + count, code, [](const TmcTableEntry &entry, const uint32_t value) {
+            return entry.code < value;
+        });
+        if (found == entries + count || found->code != code || found->text >= strings_size) {
+            return nullptr;
+        }
+        return strings + found->text;
+    }
+
+    uint32_t size() const {
+        return count;
+    }
+};
+
+/**
+ * @brief Optional content of a multi-group message: label and value of one free-format field.
+ */
+struct TmcField {
+    uint8_t label;
+    uint16_t value;
+
+    bool operator==(const TmcField &other) const {
+        return label == other.label && value == other.value;
+    }
+};
+
+/**
+ * @brief Bits of the value following each free-format label (ISO 14819-1).
+ */
+const uint8_t TMC_FIELD_BITS[16] = {3, 3, 5, 5, 5, 8, 8, 8, 8, 11, 16, 16, 16, 16, 0, 0};
+
+const char *const TMC_FIELD_NAMES[16] = {
+        "Duration", "Control code", "Length of route affected", "Speed limit", "Quantifier", "Quantifier",
+        "Supplementary information", "Start time", "Stop time", "Additional event", "Diversion route",
+        "Destination", "Reserved", "Source location", "Separator", "Reserved",
+};
+
+struct TmcMessage {
+    bool multi_group = false;
+    uint8_t continuity_index = 0; // Multi-group only
+    bool diversion = false;       // Single group only
+    bool negative = false;        // Direction of the queue growth
+    uint8_t extent = 0;
+    uint16_t event = 0;
+    uint16_t location = 0;
+    uint8_t duration = 0;         // Duration and persistence of single groups, label 0 of multi-group messages
+    std::vector<TmcField> fields;
+
+    bool operator==(const TmcMessage &other) const {
+        return multi_group == other.multi_group && continuity_index == other.continuity_index && diversion == other.diversion
+               && negative == other.negative && extent == other.extent && event == other.event && location == other.location
+               && duration == other.duration && fields == other.fields;
+    }
+
+    bool operator!=(const TmcMessage &other) const {
+        return !(*this == other);
+    }
+};
+
+enum class TmcResult {
+    PARTIAL,  // Part of a multi-group message stored
+    MESSAGE,  // Message complete
+    TUNING,   // Tuning / system information, not decoded
+    DROPPED   // Group out of sequence, the partial message is discarded
+};
+
+/**
+ * @brief Reassembles the 8A groups of one station (PI) into messages, one partial message per continuity index.
+ */
+class TmcAssembler {
+private:
+    struct Partial {
+        bool active = false;
+        TmcMessage message;
+        uint32_t free_format[TMC_SUBSEQUENT_GROUPS_MAX]; // 28 bits per subsequent group
+        int groups = 0;      // Subsequent groups stored
+        int remaining = 0;   // Groups still to follow after the last stored one
+    };
+
+    Partial partials[TMC_CONTINUITY_INDICES];
+
+    /**
+     * @brief Splits the free-format bits into labelled fields, trailing zero bits are padding.
+     */
+    static void _parse_free_format(const Partial &partial, TmcMessage &message) {
+        const int total = partial.groups * TMC_FREE_FORMAT_BITS;
+        auto bit = [&partial](const int position) {
+            const uint32_t word = partial.free_format[position / TMC_FREE_FORMAT_BITS];
+            return (word >> (TMC_FREE_FORMAT_BITS - 1 - position % TMC_FREE_FORMAT_BITS)) & 0x1;
+        };
+        auto read = [&bit](const int position, const int bits) {
+            uint32_t value = 0;
+            for (int i = position; i < position + bits; ++i) {
+                value = (value << 1) | bit(i);
+            }
+            return value;
+        };
+        auto is_padding = [&bit, total](const int position) {
+            for (int i = position; i < total; ++i) {
+                if (bit(i)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        int position = 0;
+        while (total - position >= TMC_LABEL_BITS && !is_padding(position)) {
+            const auto label = static_cast<uint8_t>(read(position, TMC_LABEL_BITS));
+            position += TMC_LABEL_BITS;
+            const int bits = TMC_FIELD_BITS[label];
+            if (bits > total - position) {
+                break;
+            }
+            const auto value = static_cast<uint16_t>(read(position, bits));
+            position += bits;
+            if (label == TMC_LABEL_SEPARATOR) {
+                continue;
+            }
+            if (label == TMC_LABEL_DURATION) {
+                message.duration = static_cast<uint8_t>(value);
+            }
+            message.fields.push_back(TmcField{label, value});
+        }
+    }
+
+public:
+    /**
+     * @brief Takes one 8A group, `message` is filled in when the result is MESSAGE.
+     */
+    TmcResult push(const uint16_t block_B, const uint16_t block_C, const uint16_t block_D, TmcMessage &message) {
+        if (Group8A::Tuning::get(block_B)) {
+            return TmcResult::TUNING;
+        }
+
+        if (Group8A::SingleGroup::get(block_B)) {
+            message = TmcMessage();
+            message.diversion = Group8A::Diversion::get(block_C) != 0;
+            message.negative = Group8A::Direction::get(block_C) != 0;
+            message.extent = static_cast<uint8_t>(Group8A::Extent::get(block_C));
+            message.event = Group8A::Event::get(block_C);
+            message.location = Group8A::Location::get(block_D);
+            message.duration = static_cast<uint8_t>(Group8A::DurationPersistence::get(block_B));
+            return TmcResult::MESSAGE;
+        }
+
+        const auto continuity_index = static_cast<uint8_t>(Group8A::ContinuityIndex::get(block_B));
+        Partial &partial = partials[continuity_index];
+        if (Group8A::FirstGroup::get(block_C)) {
+            // A first group always starts over, also when it repeats a message already received
+            partial.active = true;
+            partial.groups = 0;
+            partial.message = TmcMessage();
+            partial.message.multi_group = true;
+            partial.message.continuity_index = continuity_index;
+            partial.message.negative = Group8A::Direction::get(block_C) != 0;
+            partial.message.extent = static_cast<uint8_t>(Group8A::Extent::get(block_C));
+            partial.message.event = Group8A::Event::get(block_C);
+            partial.message.location = Group8A::Location::get(block_D);
+            return TmcResult::PARTIAL;
+        }
+
+        const bool second = Group8A::SecondGroup::get(block_C) != 0;
+        const int sequence = Group8A::SequenceIndex::get(block_C);
+        if (!partial.active || second != (partial.groups == 0) || (!second && sequence != partial.remaining - 1)) {
+            partial.active = false;
+            return TmcResult::DROPPED;
+        }
+        partial.free_format[partial.groups++] = (static_cast<uint32_t>(Group8A::FreeFormat::get(block_C)) << DATA_BITS) | block_D;
+        partial.remaining = sequence;
+        if (partial.remaining > 0) {
+            return TmcResult::PARTIAL;
+        }
+
+        partial.active = false;
+        message = partial.message;
+        _parse_free_format(partial, message);
+        return TmcResult::MESSAGE;
+    }
+};
+
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file trace.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Low-overhead binary tracing. Every thread owns a fixed-size ring of
+ * fixed-size events, recording is a handful of stores (no formatting, no
+ * allocation, no locks). Rings are dumped raw to a file on demand (SIGUSR1),
+ * on error or at exit and pretty-printed offline by the rds_trace tool.
+ */
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define TRACE_ENABLED (1)
+#define TRACE_RING_SIZE (2048) // Must be a power of two
+#define TRACE_MAX_THREADS (32)
+#define TRACE_MAGIC "RDSTRACE"
+#define TRACE_VERSION (1)
+#define TRACE_PATH_MAX (4096)
+
+#define TRACE_EVENT(type, tag, a, b) \
+            do { if (TRACE_ENABLED) trace_record(type, tag, a, b); } while (0)
+
+/**
+ * @brief Kinds of recorded events, the meaning of the payload words is given per kind.
+ */
+enum class TraceEventType : uint8_t {
+    RAW_BLOCK = 1,  // tag: block position (0=A..3=D), a: 26-bit block word, b: group index
+    SYNDROME = 2,   // tag: block position, a: 26-bit block word, b: syndrome
+    OFFSET = 3,     // tag: detected offset (0=A..3=D), a: group index, b: position in the group
+    CORRECTION = 4, // tag: block position, a: received 26-bit word, b: corrected 26-bit word
+    GROUP = 5,      // tag: group type (0..15 A, 16..31 B), a: PI, b: block B
+    ERROR = 6,      // tag: error code, a: group index, b: detail
+};
+
+/**
+ * @brief Error codes stored in the tag of TraceEventType::ERROR events.
+ */
+enum class TraceErrorCode : uint8_t {
+    CRC = 1,        // No offset word matched the block
+    OFFSETS = 2,    // Offsets in the group are not unique
+    INPUT = 3,      // Malformed input
+};
+
+/**
+ * @brief One fixed-size trace record (24 bytes), written verbatim to the dump file.
+ */
+struct TraceEvent {
+    uint64_t timestamp; // Nanoseconds, steady clock
+    uint32_t sequence;  // Per-thread event counter
+    uint8_t type;       // TraceEventType
+    uint8_t tag;
+    uint16_t reserved;
+    uint32_t a;
+    uint32_t b;
+};
+
+static_assert(sizeof(TraceEvent) == 24, "TraceEvent must stay 24 bytes, the dump format depends on it");
+
+/**
+ * @brief Header of the dump file, followed by `thread_count` TraceRingHeader + events sections.
+ */
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t event_size;
+    uint32_t ring_size;
+    uint32_t thread_count;
+};
+
+struct TraceRingHeader {
+    uint32_t thread_id;
+    uint32_t head; // Sequence number of the next event, events [head - ring_size, head) are valid
+};
+
+/**
+ * @brief Single-producer ring, only the owning thread writes it.
+ * The head is published with release semantics so a dump from another thread sees complete events.
+ */
+class TraceRing {
+public:
+    TraceEvent events[TRACE_RING_SIZE];
+    std::atomic<uint32_t> head;
+    uint32_t thread_id;
+
+    void record(const TraceEventType type, const uint8_t tag, const uint32_t a, const uint32_t b) {
+        const uint32_t sequence = head.load(std::memory_order_relaxed);
+        TraceEvent &event = events[sequence & (TRACE_RING_SIZE - 1)];
+        event.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        event.sequence = sequence;
+        event.type = static_cast<uint8_t>(type);
+        event.tag = tag;
+        event.reserved = 0;
+        event.a = a;
+        event.b = b;
+        head.store(sequence + 1, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief Statically allocated rings, threads claim a slot on their first event.
+ * Static storage keeps the dump async-signal-safe (no heap, no locks).
+ */
+static TraceRing trace_rings[TRACE_MAX_THREADS];
+static std::atomic<uint32_t> trace_ring_count{0};
+static char trace_dump_path[TRACE_PATH_MAX] = {0};
+
+/**
+ * @brief Returns the ring of the calling thread, or nullptr if all slots are taken.
+ */
+TraceRing *trace_thread_ring() {
+    thread_local TraceRing *ring = nullptr;
+    thread_local bool claimed = false;
+    if (!claimed) {
+        claimed = true;
+        const uint32_t slot = trace_ring_count.fetch_add(1, std::memory_order_acq_rel);
+        if (slot < TRACE_MAX_THREADS) {
+            ring = &trace_rings[slot];
+            ring->thread_id = slot;
+        }
+    }
+    return ring;
+}
+
+/**
+ * @brief Records one event into the calling thread's ring.
+ */
+void trace_record(const TraceEventType type, const uint8_t tag, const uint32_t a, const uint32_t b) {
+    TraceRing *ring = trace_thread_ring();
+    if (ring != nullptr) {
+        ring->record(type, tag, a, b);
+    }
+}
+
+/**
+ * @brief Writes all rings to the given file. Uses only open/write/close, so it is safe to call from a signal handler.
+ *
+ * @return true if the whole dump was written.
+ */
+bool trace_dump(const char *path) {
+    if (path == nullptr || path[0] == '\0') {
+        return false;
+    }
+
+    const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    uint32_t thread_count = trace_ring_count.load(std::memory_order_acquire);
+    if (thread_count > TRACE_MAX_THREADS) {
+        thread_count = TRACE_MAX_THREADS;
+    }
+
+    TraceFileHeader header;
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.event_size = sizeof(TraceEvent);
+    header.ring_size = TRACE_RING_SIZE;
+    header.thread_count = thread_count;
+
+    bool ok = write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header));
+    for (uint32_t i = 0; ok && i < thread_count; ++i) {
+        TraceRingHeader ring_header;
+        ring_header.thread_id = trace_rings[i].thread_id;
+        ring_header.head = trace_rings[i].head.load(std::memory_order_acquire);
+        ok = write(fd, &ring_header, sizeof(ring_header)) == static_cast<ssize_t>(sizeof(ring_header));
+        ok = ok && write(fd, trace_rings[i].events, sizeof(trace_rings[i].events)) == static_cast<ssize_t>(sizeof(trace_rings[i].events));
+    }
+
+    close(fd);
+    return ok;
+}
+
+/**
+ * @brief Dumps to the configured path, no-op if tracing to a file was not requested.
+ */
+bool trace_dump() {
+    return trace_dump(trace_dump_path);
+}
+
+extern "C" void trace_signal_handler(int) {
+    trace_dump();
+}
+
+/**
+ * @brief Sets the dump path and installs a SIGUSR1 handler that dumps the rings on demand.
+ */
+void trace_set_dump_path(const char *path) {
+    if (path == nullptr) {
+        return;
+    }
+    std::strncpy(trace_dump_path, path, TRACE_PATH_MAX - 1);
+    trace_dump_path[TRACE_PATH_MAX - 1] = '\0';
+    std::signal(SIGUSR1, trace_signal_handler);
+}
+
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file wav.hpp
+ * @author Zdeněk Lapeš <lapes.zdenek@gmail.com>
+ * @date 2026-10-18
+ *
+ * Sample files: WAV (32-bit IEEE float, 16-bit PCM when reading) or headerless raw little-endian floats.
+ */
+#ifndef WAV_HPP
+#define WAV_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "mapped_file.hpp"
+
+#define WAV_FORMAT_PCM (1)
+#define WAV_FORMAT_IEEE_FLOAT (3)
+#define WAV_HEADER_SIZE (44)
+
+class SampleWriter {
+private:
+    std::ofstream file;
+    uint32_t sample_rate;
+    bool raw;
+    uint64_t samples = 0;
+    bool closed = false;
+
+    static void _put_u16(char *out, const uint16_t value) {
+        out[0] = static_cast<char>(value & 0xFF);
+        out[1] = static_cast<char>(value >> 8);
+    }
+
+    static void _put_u32(char *out, const uint32_t value) {
+        _put_u16(out, static_cast<uint16_t>(value & 0xFFFF));
+        _put_u16(out + 2, static_cast<uint16_t>(value >> 16));
+    }
+
+    void _write_header() {
+        // NOTE: Sizes over 4 GiB do not fit the RIFF header, they are clamped (most readers then read to the end of file)
+        const uint64_t data_size = samples * sizeof(float);
+        const uint32_t data_size_32 = data_size > 0xFFFFFFFFULL - 36 ? 0xFFFFFFFFU - 36 : static_cast<uint32_t>(data_size);
+
+        char header[WAV_HEADER_SIZE];
+        std::memcpy(header, "RIFF", 4);
+        _put_u32(header + 4, 36 + data_size_32);
+        std::memcpy(header + 8, "WAVEfmt ", 8);
+        _put_u32(header + 16, 16);
+        _put_u16(header + 20, WAV_FORMAT_IEEE_FLOAT);
+        _put_u16(header + 22, 1);
+        _put_u32(header + 24, sample_rate);
+        _put_u32(header + 28, sample_rate * static_cast<uint32_t>(sizeof(float)));
+        _put_u16(header + 32, sizeof(float));
+        _put_u16(header + 34, 8 * sizeof(float));
+        std::memcpy(header + 36, "data", 4);
+        _put_u32(header + 40, data_size_32);
+        file.write(header, sizeof(header));
+    }
+
+public:
+    /**
+     * @param raw Write headerless little-endian floats instead of WAV
+     */
+    SampleWriter(const std::string &path, const uint32_t sample_rate, const bool raw) : file(path, std::ios::binary | std::ios::trunc), sample_rate(sample_rate), raw(raw) {
+        if (!file) {
+            throw std::invalid_argument("Cannot create sample file: " + path);
+        }
+        if (!raw) {
+            // Placeholder, sizes are filled in by close()
+            _write_header();
+        }
+    }
+
+    ~SampleWriter() {
+        close();
+    }
+
+    void write(const float *data, const std::size_t count) {
+        file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(float)));
+        if (!file) {
+            throw std::invalid_argument("Cannot write sample file.");
+        }
+        samples += count;
+    }
+
+    void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        if (!raw) {
+            file.seekp(0);
+            _write_header();
+        }
+        file.close();
+    }
+};
+
+/**
+ * @brief Sequential reader of the first channel of a WAV (16-bit PCM or 32-bit float) or raw float file.
+ */
+class SampleReader {
+private:
+    MappedFile file;
+    uint32_t rate = 0;
+    uint16_t format = WAV_FORMAT_IEEE_FLOAT;
+    uint16_t channels = 1;
+    std::size_t frame_size = sizeof(float);
+    const uint8_t *data = nullptr;
+    std::size_t frames = 0;
+    std::size_t position = 0;
+
+    static uint16_t _get_u16(const uint8_t *in) {
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    static uint32_t _get_u32(const uint8_t *in) {
+        return static_cast<uint32_t>(_get_u16(in)) | (static_cast<uint32_t>(_get_u16(in + 2)) << 16);
+    }
+
+    void _parse_wav(const std::string &path) {
+        const uint8_t *bytes = file.bytes();
+        const std::size_t size = file.length();
+        if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0) {
+            throw std::invalid_argument("Not a WAV file: " + path + " (use -raw for raw float samples)");
+        }
+
+        bool has_format = false;
+        std::size_t offset = 12;
+        while (offset + 8 <= size) {
+            const uint32_t chunk_size = _get_u32(bytes + offset + 4);
+            const uint8_t *chunk = bytes + offset + 8;
+            if (std::memcmp(bytes + offset, "fmt ", 4) == 0 && chunk_size >= 16 && offset + 8 + 16 <= size) {
+                format = _get_u16(chunk);
+                channels = _get_u16(chunk + 2);
+                rate = _get_u32(chunk + 4);
+                const uint16_t bits = _get_u16(chunk + 14);
+                if (!((format == WAV_FORMAT_IEEE_FLOAT && bits == 32) || (format == WAV_FORMAT_PCM && bits == 16)) || channels == 0) {
+                    throw std::invalid_argument("Unsupported WAV format in " + path + ", expected 32-bit float or 16-bit PCM");
+                }
+                frame_size = channels * (bits / 8u);
+                has_format = true;
+            } else if (std::memcmp(bytes + offset, "data", 4) == 0) {
+                if (!has_format) {
+                    throw std::invalid_argument("WAV file has no format chunk before data: " + path);
+                }
+                // NOTE: Files over 4 GiB have a clamped data size, the data then runs to the end of the file
+                const std::size_t available = size - (offset + 8);
+                const std::size_t data_size = chunk_size >= 0xFFFFFFFFU - 36 || chunk_size > available ? available : chunk_size;
+                data = chunk;
+                frames = data_size / frame_size;
+                return;
+            }
+            offset += 8 + chunk_size + (chunk_size & 0x1);
+        }
+        throw std::invalid_argument("WAV file has no data chunk: " + path);
+    }
+
+public:
+    /**
+     * @param raw Headerless little-endian 32-bit floats, `raw_rate` is then the sample rate
+     */
+    SampleReader(const std::string &path, const bool raw, const uint32_t raw_rate) : file(path) {
+        file.advise_sequential();
+        if (raw) {
+            rate = raw_rate;
+            data = file.bytes();
+            frames = file.length() / sizeof(float);
+        } else {
+            _parse_wav(path);
+        }
+    }
+
+    uint32_t sample_rate() const {
+        return rate;
+    }
+
+    /**
+     * @brief Reads up to `count` samples of the first channel.
+     *
+     * @return Samples read, 0 at the end of the file
+     */
+    std::size_t read(float *out, const std::size_t count) {
+        const std::size_t n = frames - position < count ? frames - position : count;
+        if (n == 0) {
+            return 0;
+        }
+        const uint8_t *in = data + position * frame_size;
+        if (format == WAV_FORMAT_IEEE_FLOAT && channels == 1) {
+            std::memcpy(out, in, n * sizeof(float));
+        } else if (format == WAV_FORMAT_IEEE_FLOAT) {
+            for (std::size_t i = 0; i < n; ++i) {
+                std::memcpy(out + i, in + i * frame_size, sizeof(float));
+            }
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<float>(static_cast<int16_t>(_get_u16(in + i * frame_size))) / 32768.0f;
+            }
+        }
+        position += n;
+        return n;
+    }
+};
+
+
+#endif